@@ -5,9 +5,11 @@
 #include <filesystem>
 #include <format>
 #include <iostream>
+#include <optional>
 #include <print>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "tlct.hpp"
@@ -17,6 +19,228 @@
 namespace fs = std::filesystem;
 namespace rgs = std::ranges;
 
+template <tlct::io::concepts::CFrameReader TReader>
+static std::expected<void, tlct::Error> readFrame(TReader& reader, tlct::io::YuvPlanarFrame& frame) noexcept {
+    return reader.readInto(frame);
+}
+
+static std::expected<void, tlct::Error> readFrame(tlct::io::YuvPlanarMmapReader& reader,
+                                                  tlct::io::YuvPlanarFrame& frame) noexcept {
+    // Zero-copy: the frame becomes a view into the mapped file
+    auto frameRes = reader.read();
+    if (!frameRes) return std::unexpected{std::move(frameRes.error())};
+    frame = std::move(frameRes.value());
+    return {};
+}
+
+template <typename TReader>
+static std::expected<void, tlct::Error> readFrame(tlct::io::PrefetchReader_<TReader>& reader,
+                                                  tlct::io::YuvPlanarFrame& frame) noexcept {
+    return reader.readInto(frame);
+}
+
+template <tlct::io::concepts::CFrameReader TReader>
+static std::expected<void, tlct::Error> skipFrames(TReader& reader, int frameCount) noexcept {
+    return reader.skip(frameCount);
+}
+
+template <typename TReader>
+static std::expected<void, tlct::Error> skipFrames([[maybe_unused]] tlct::io::PrefetchReader_<TReader>& reader,
+                                                   [[maybe_unused]] int frameCount) noexcept {
+    // The prefetcher strides on its own
+    return {};
+}
+
+template <tlct::io::concepts::CFrameWriter TWriter>
+static std::expected<void, tlct::Error> writeFrame(std::vector<TWriter>& writers, int view,
+                                                   tlct::io::YuvPlanarFrame& frame) noexcept {
+    return writers[view].write(frame);
+}
+
+template <tlct::io::concepts::CFrameWriter TWriter>
+static std::expected<void, tlct::Error> writeFrame(tlct::io::AsyncWriter_<TWriter>& writer, int view,
+                                                   tlct::io::YuvPlanarFrame& frame) noexcept {
+    return writer.write(view, frame);
+}
+
+template <tlct::io::concepts::CFrameWriter TWriter>
+static std::expected<void, tlct::Error> flushFrames([[maybe_unused]] std::vector<TWriter>& writers) noexcept {
+    return {};
+}
+
+template <tlct::io::concepts::CFrameWriter TWriter>
+static std::expected<void, tlct::Error> flushFrames(tlct::io::AsyncWriter_<TWriter>& writer) noexcept {
+    return writer.flush();
+}
+
+static void pasteTile(const tlct::io::YuvPlanarFrame& tile, tlct::io::YuvPlanarFrame& mosaic, int tileRow,
+                      int tileCol) noexcept {
+    const auto& extent = tile.getExtent();
+    const auto paste = [=](const cv::Mat& src, cv::Mat& dst, cv::Size size) {
+        const cv::Rect roi{tileCol * size.width, tileRow * size.height, size.width, size.height};
+        src.copyTo(dst(roi));
+    };
+    paste(tile.getY(), mosaic.getY(), extent.getYSize());
+    paste(tile.getU(), mosaic.getU(), extent.getUSize());
+    paste(tile.getV(), mosaic.getV(), extent.getVSize());
+}
+
+template <tlct::concepts::CManager TManager, typename TReader, typename TWriters>
+static std::expected<void, tlct::Error> convertFrames(const tlct::CliConfig& cliCfg, TManager& manager,
+                                                      TReader& yuvReader, TWriters& yuvWriters,
+                                                      const tlct::io::YuvPlanarExtent& srcExtent,
+                                                      const tlct::io::YuvPlanarExtent& mvExtent,
+                                                      const tlct::io::YuvPlanarExtent& dstExtent) noexcept {
+    const bool muxed = tlct::io::isStdioPath(cliCfg.path.dst);
+    auto srcFrame = tlct::io::YuvPlanarFrame::create(srcExtent).value();
+    // Views are rendered in parallel one view row at a time
+    std::vector<tlct::io::YuvPlanarFrame> mvFrames;
+    mvFrames.reserve(cliCfg.convert.views);
+    for ([[maybe_unused]] const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
+        mvFrames.push_back(tlct::io::YuvPlanarFrame::create(mvExtent).value());
+    }
+    std::vector<cv::Point> viewIndices(cliCfg.convert.views);
+    std::optional<tlct::io::YuvPlanarFrame> mosaicFrame;
+    if (cliCfg.io.mosaic) {
+        mosaicFrame = tlct::io::YuvPlanarFrame::create(dstExtent).value();
+    }
+    const auto fids = rgs::views::iota(cliCfg.range.begin, cliCfg.range.end) | rgs::views::stride(cliCfg.range.step);
+    for (const int fid : fids) {
+        if (fid != cliCfg.range.begin && cliCfg.range.step > 1) {
+            auto strideRes = skipFrames(yuvReader, cliCfg.range.step - 1);
+            if (!strideRes) return std::unexpected{std::move(strideRes.error())};
+        }
+
+        auto readRes = readFrame(yuvReader, srcFrame);
+        if (!readRes) return std::unexpected{std::move(readRes.error())};
+
+        auto updateRes = manager.update(srcFrame);
+        if (!updateRes) return std::unexpected{std::move(updateRes.error())};
+
+        int view = 0;
+        for (const int viewRow : rgs::views::iota(0, cliCfg.convert.views)) {
+            for (const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
+                viewIndices[viewCol] = {viewCol, viewRow};
+            }
+
+            auto renderRes = manager.renderViews(mvFrames, viewIndices);
+            if (!renderRes) return std::unexpected{std::move(renderRes.error())};
+
+            for (const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
+                auto& mvFrame = mvFrames[viewCol];
+                if (mosaicFrame.has_value()) {
+                    pasteTile(mvFrame, mosaicFrame.value(), viewRow, viewCol);
+                } else {
+                    auto writeRes = writeFrame(yuvWriters, muxed ? 0 : view, mvFrame);
+                    if (!writeRes) return std::unexpected{std::move(writeRes.error())};
+                }
+
+                view++;
+            }
+        }
+
+        if (mosaicFrame.has_value()) {
+            auto writeRes = writeFrame(yuvWriters, 0, mosaicFrame.value());
+            if (!writeRes) return std::unexpected{std::move(writeRes.error())};
+        }
+    }
+
+    return flushFrames(yuvWriters);
+}
+
+template <tlct::concepts::CManager TManager, typename TReader, tlct::io::concepts::CFrameWriter TWriter>
+static std::expected<void, tlct::Error> convertWithWriters(const tlct::CliConfig& cliCfg, TManager& manager,
+                                                           TReader& yuvReader, std::vector<TWriter>&& yuvWriters,
+                                                           const tlct::io::YuvPlanarExtent& srcExtent,
+                                                           const tlct::io::YuvPlanarExtent& mvExtent,
+                                                           const tlct::io::YuvPlanarExtent& dstExtent) noexcept {
+    if (cliCfg.io.writeQueue > 0) {
+        auto asyncWriterRes =
+            tlct::io::AsyncWriter_<TWriter>::create(std::move(yuvWriters), dstExtent, cliCfg.io.writeQueue);
+        if (!asyncWriterRes) return std::unexpected{std::move(asyncWriterRes.error())};
+        return convertFrames(cliCfg, manager, yuvReader, asyncWriterRes.value(), srcExtent, mvExtent, dstExtent);
+    }
+
+    return convertFrames(cliCfg, manager, yuvReader, yuvWriters, srcExtent, mvExtent, dstExtent);
+}
+
+template <tlct::concepts::CManager TManager, typename TReader>
+static std::expected<void, tlct::Error> convertWithDst(const tlct::CliConfig& cliCfg, TManager& manager,
+                                                       TReader& yuvReader, const tlct::io::YuvPlanarExtent& srcExtent,
+                                                       const tlct::io::Y4mHeader& mvHeader) noexcept {
+    const auto& mvExtent = mvHeader.getExtent();
+    const fs::path& dstdir = cliCfg.path.dst;
+    // With `-o -` all outputs are multiplexed into stdout, view by view within each frame
+    const bool muxed = tlct::io::isStdioPath(dstdir);
+    if (!muxed) {
+        fs::create_directories(dstdir);
+    }
+
+    // With `--mosaic` all views of a frame are tiled row-major into one frame
+    auto dstExtent = mvExtent;
+    if (cliCfg.io.mosaic) {
+        const int views = cliCfg.convert.views;
+        auto mosaicExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(
+            mvExtent.getYWidth() * views, mvExtent.getYHeight() * views, mvExtent.getBitDepth());
+        if (!mosaicExtentRes) return std::unexpected{std::move(mosaicExtentRes.error())};
+        dstExtent = mosaicExtentRes.value();
+    }
+
+    const int totalWriters = (muxed || cliCfg.io.mosaic) ? 1 : cliCfg.convert.views * cliCfg.convert.views;
+    const auto dstFilename = [&](int i, std::string_view suffix) {
+        if (cliCfg.io.mosaic) {
+            return std::format("mosaic-{}x{}.{}", dstExtent.getYWidth(), dstExtent.getYHeight(), suffix);
+        }
+        return std::format("v{:03}-{}x{}.{}", i, dstExtent.getYWidth(), dstExtent.getYHeight(), suffix);
+    };
+
+    if (cliCfg.io.y4m) {
+        auto dstHeaderRes = tlct::io::Y4mHeader::create(dstExtent, mvHeader.getFpsNum(), mvHeader.getFpsDen());
+        if (!dstHeaderRes) return std::unexpected{std::move(dstHeaderRes.error())};
+        const auto& dstHeader = dstHeaderRes.value();
+
+        std::vector<tlct::io::Y4mWriter> y4mWriters;
+        y4mWriters.reserve(totalWriters);
+        for (const int i : rgs::views::iota(0, totalWriters)) {
+            fs::path savetoPath = muxed ? dstdir : dstdir / dstFilename(i, "y4m");
+            auto y4mWriterRes = tlct::io::Y4mWriter::create(savetoPath, dstHeader);
+            if (!y4mWriterRes) return std::unexpected{std::move(y4mWriterRes.error())};
+            y4mWriters.push_back(std::move(y4mWriterRes.value()));
+        }
+        return convertWithWriters(cliCfg, manager, yuvReader, std::move(y4mWriters), srcExtent, mvExtent, dstExtent);
+    }
+
+    std::vector<tlct::io::YuvPlanarWriter> yuvWriters;
+    yuvWriters.reserve(totalWriters);
+    for (const int i : rgs::views::iota(0, totalWriters)) {
+        fs::path savetoPath = muxed ? dstdir : dstdir / dstFilename(i, "yuv");
+        auto yuvWriterRes = tlct::io::YuvPlanarWriter::create(savetoPath);
+        if (!yuvWriterRes) return std::unexpected{std::move(yuvWriterRes.error())};
+        yuvWriters.push_back(std::move(yuvWriterRes.value()));
+    }
+    return convertWithWriters(cliCfg, manager, yuvReader, std::move(yuvWriters), srcExtent, mvExtent, dstExtent);
+}
+
+template <tlct::concepts::CManager TManager, typename TReader>
+static std::expected<void, tlct::Error> convertWithReader(const tlct::CliConfig& cliCfg, TManager& manager,
+                                                          TReader&& yuvReader,
+                                                          const tlct::io::YuvPlanarExtent& srcExtent,
+                                                          const tlct::io::Y4mHeader& mvHeader) noexcept {
+    auto skipRes = yuvReader.skip(cliCfg.range.begin);
+    if (!skipRes) return std::unexpected{std::move(skipRes.error())};
+
+    if (cliCfg.io.prefetch > 0) {
+        const int rangeSize = cliCfg.range.end - cliCfg.range.begin;
+        const int frameCount = (rangeSize + cliCfg.range.step - 1) / cliCfg.range.step;
+        auto prefetchReaderRes = tlct::io::PrefetchReader_<TReader>::create(
+            std::move(yuvReader), srcExtent, cliCfg.io.prefetch, frameCount, cliCfg.range.step);
+        if (!prefetchReaderRes) return std::unexpected{std::move(prefetchReaderRes.error())};
+        return convertWithDst(cliCfg, manager, prefetchReaderRes.value(), srcExtent, mvHeader);
+    }
+
+    return convertWithDst(cliCfg, manager, yuvReader, srcExtent, mvHeader);
+}
+
 template <tlct::concepts::CManager TManager>
 static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
                                                const tlct::ConfigMap& calibCfg) noexcept {
@@ -37,60 +261,50 @@ static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
         std::swap(mvSize.width, mvSize.height);
     }
 
-    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(srcSize.width, srcSize.height);
+    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(srcSize.width, srcSize.height,
+                                                                 cliCfg.convert.bitDepth);
     if (!srcExtentRes) return std::unexpected{std::move(srcExtentRes.error())};
     auto srcExtent = srcExtentRes.value();
 
-    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(mvSize.width, mvSize.height);
+    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(mvSize.width, mvSize.height, cliCfg.convert.bitDepth);
     if (!mvExtentRes) return std::unexpected{std::move(mvExtentRes.error())};
     auto mvExtent = mvExtentRes.value();
 
-    auto yuvReaderRes = tlct::io::YuvPlanarReader::create(cliCfg.path.src, srcExtent);
-    if (!yuvReaderRes) return std::unexpected{std::move(yuvReaderRes.error())};
-    auto& yuvReader = yuvReaderRes.value();
+    if (cliCfg.path.src.extension() == ".y4m") {
+        auto y4mReaderRes = tlct::io::Y4mReader::create(cliCfg.path.src);
+        if (!y4mReaderRes) return std::unexpected{std::move(y4mReaderRes.error())};
+        auto& y4mReader = y4mReaderRes.value();
 
-    const fs::path& dstdir = cliCfg.path.dst;
-    fs::create_directories(dstdir);
-    std::vector<tlct::io::YuvPlanarWriter> yuvWriters;
-    const int totalWriters = cliCfg.convert.views * cliCfg.convert.views;
-    yuvWriters.reserve(totalWriters);
-    for (const int i : rgs::views::iota(0, totalWriters)) {
-        std::string filename = std::format("v{:03}-{}x{}.yuv", i, mvSize.width, mvSize.height);
-        fs::path savetoPath = dstdir / filename;
-        auto yuvWriterRes = tlct::io::YuvPlanarWriter::create(savetoPath);
-        if (!yuvWriterRes) return std::unexpected{std::move(yuvWriterRes.error())};
-        yuvWriters.push_back(std::move(yuvWriterRes.value()));
-    }
-
-    auto skipRes = yuvReader.skip(cliCfg.range.begin);
-    if (!skipRes) return std::unexpected{std::move(skipRes.error())};
-
-    auto srcFrame = tlct::io::YuvPlanarFrame::create(srcExtent).value();
-    auto mvFrame = tlct::io::YuvPlanarFrame::create(mvExtent).value();
-    for ([[maybe_unused]] const int fid : rgs::views::iota(cliCfg.range.begin, cliCfg.range.end)) {
-        auto readRes = yuvReader.readInto(srcFrame);
-        if (!readRes) return std::unexpected{std::move(readRes.error())};
-
-        auto updateRes = manager.update(srcFrame);
-        if (!updateRes) return std::unexpected{std::move(updateRes.error())};
+        const auto& y4mExtent = y4mReader.getExtent();
+        if (y4mExtent.getYSize() != srcExtent.getYSize() || y4mExtent.getBitDepth() != srcExtent.getBitDepth() ||
+            y4mExtent.getUShift() != srcExtent.getUShift()) [[unlikely]] {
+            auto errMsg = std::format("y4m input {}x{} {}bit mismatches the expected yuv420p {}x{} {}bit",
+                                      y4mExtent.getYWidth(), y4mExtent.getYHeight(), y4mExtent.getBitDepth(),
+                                      srcExtent.getYWidth(), srcExtent.getYHeight(), srcExtent.getBitDepth());
+            return std::unexpected{tlct::Error{tlct::ECate::eTLCT, tlct::ECode::eUnexValue, std::move(errMsg)}};
+        }
 
-        int view = 0;
-        for (const int viewRow : rgs::views::iota(0, cliCfg.convert.views)) {
-            for (const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
-                auto& yuvWriter = yuvWriters[view];
+        // Keep the frame rate of the source
+        const auto& srcHeader = y4mReader.getHeader();
+        auto mvHeaderRes = tlct::io::Y4mHeader::create(mvExtent, srcHeader.getFpsNum(), srcHeader.getFpsDen());
+        if (!mvHeaderRes) return std::unexpected{std::move(mvHeaderRes.error())};
 
-                auto renderRes = manager.renderInto(mvFrame, viewRow, viewCol);
-                if (!renderRes) return std::unexpected{std::move(renderRes.error())};
+        return convertWithReader(cliCfg, manager, std::move(y4mReader), srcExtent, mvHeaderRes.value());
+    }
 
-                auto writeRes = yuvWriter.write(mvFrame);
-                if (!writeRes) return std::unexpected{std::move(writeRes.error())};
+    auto mvHeaderRes = tlct::io::Y4mHeader::create(mvExtent, 30, 1);
+    if (!mvHeaderRes) return std::unexpected{std::move(mvHeaderRes.error())};
+    const auto& mvHeader = mvHeaderRes.value();
 
-                view++;
-            }
-        }
+    if (cliCfg.io.mmap) {
+        auto yuvReaderRes = tlct::io::YuvPlanarMmapReader::create(cliCfg.path.src, srcExtent);
+        if (!yuvReaderRes) return std::unexpected{std::move(yuvReaderRes.error())};
+        return convertWithReader(cliCfg, manager, std::move(yuvReaderRes.value()), srcExtent, mvHeader);
+    } else {
+        auto yuvReaderRes = tlct::io::YuvPlanarReader::create(cliCfg.path.src, srcExtent);
+        if (!yuvReaderRes) return std::unexpected{std::move(yuvReaderRes.error())};
+        return convertWithReader(cliCfg, manager, std::move(yuvReaderRes.value()), srcExtent, mvHeader);
     }
-
-    return {};
 }
 
 bool isMultiFocus(const tlct::ConfigMap& calibCfg) { return calibCfg.getOr<"NearFocalLenType">(-1) >= 0; }
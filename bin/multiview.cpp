@@ -37,11 +37,12 @@ static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
         std::swap(mvSize.width, mvSize.height);
     }
 
-    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(srcSize.width, srcSize.height);
+    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(srcSize.width, srcSize.height,
+                                                                 cliCfg.convert.bitDepth);
     if (!srcExtentRes) return std::unexpected{std::move(srcExtentRes.error())};
     auto srcExtent = srcExtentRes.value();
 
-    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(mvSize.width, mvSize.height);
+    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(mvSize.width, mvSize.height, cliCfg.convert.bitDepth);
     if (!mvExtentRes) return std::unexpected{std::move(mvExtentRes.error())};
     auto mvExtent = mvExtentRes.value();
 
@@ -62,31 +63,50 @@ static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
         yuvWriters.push_back(std::move(yuvWriterRes.value()));
     }
 
+    auto bridgeReaderRes = manager.createBridgeReader(dstdir / "bridge.bin");
+    if (!bridgeReaderRes) return std::unexpected{std::move(bridgeReaderRes.error())};
+    auto& bridgeReader = bridgeReaderRes.value();
+
     auto skipRes = yuvReader.skip(cliCfg.range.begin);
     if (!skipRes) return std::unexpected{std::move(skipRes.error())};
 
     auto srcFrame = tlct::io::YuvPlanarFrame::create(srcExtent).value();
-    auto mvFrame = tlct::io::YuvPlanarFrame::create(mvExtent).value();
-    for ([[maybe_unused]] const int fid : rgs::views::iota(cliCfg.range.begin, cliCfg.range.end)) {
+    // Views are rendered in parallel one view row at a time
+    std::vector<tlct::io::YuvPlanarFrame> mvFrames;
+    mvFrames.reserve(cliCfg.convert.views);
+    for ([[maybe_unused]] const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
+        mvFrames.push_back(tlct::io::YuvPlanarFrame::create(mvExtent).value());
+    }
+    std::vector<cv::Point> viewIndices(cliCfg.convert.views);
+    const auto fids = rgs::views::iota(cliCfg.range.begin, cliCfg.range.end) | rgs::views::stride(cliCfg.range.step);
+    for ([[maybe_unused]] const int fid : fids) {
+        if (fid != cliCfg.range.begin && cliCfg.range.step > 1) {
+            auto strideRes = yuvReader.skip(cliCfg.range.step - 1);
+            if (!strideRes) return std::unexpected{std::move(strideRes.error())};
+        }
+
         auto readRes = yuvReader.readInto(srcFrame);
         if (!readRes) return std::unexpected{std::move(readRes.error())};
 
         auto updateRes = manager.updateCommonCache(srcFrame);
         if (!updateRes) return std::unexpected{std::move(updateRes.error())};
 
-        std::string filename = std::format("v{:03}.bin", fid);
-        fs::path psizePath = dstdir / filename;
-        manager.loadBridge(psizePath) | unwrap;
+        auto loadRes = manager.loadBridge(bridgeReader, fid);
+        if (!loadRes) return std::unexpected{std::move(loadRes.error())};
 
         int view = 0;
         for (const int viewRow : rgs::views::iota(0, cliCfg.convert.views)) {
             for (const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
-                auto& yuvWriter = yuvWriters[view];
+                viewIndices[viewCol] = {viewCol, viewRow};
+            }
+
+            auto renderRes = manager.renderViews(mvFrames, viewIndices);
+            if (!renderRes) return std::unexpected{std::move(renderRes.error())};
 
-                auto renderRes = manager.renderInto(mvFrame, viewRow, viewCol);
-                if (!renderRes) return std::unexpected{std::move(renderRes.error())};
+            for (const int viewCol : rgs::views::iota(0, cliCfg.convert.views)) {
+                auto& yuvWriter = yuvWriters[view];
 
-                auto writeRes = yuvWriter.write(mvFrame);
+                auto writeRes = yuvWriter.write(mvFrames[viewCol]);
                 if (!writeRes) return std::unexpected{std::move(writeRes.error())};
 
                 view++;
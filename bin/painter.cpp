@@ -108,7 +108,8 @@ static std::expected<void, tlct::Error> paint(const tlct::CliConfig& cliCfg, con
         std::swap(dstSize.width, dstSize.height);
     }
 
-    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(srcSize.width, srcSize.height);
+    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(srcSize.width, srcSize.height,
+                                                                 cliCfg.convert.bitDepth);
     if (!srcExtentRes) return std::unexpected{std::move(srcExtentRes.error())};
     auto srcExtent = srcExtentRes.value();
 
@@ -135,7 +136,13 @@ static std::expected<void, tlct::Error> paint(const tlct::CliConfig& cliCfg, con
     auto srcFrame = tlct::io::YuvPlanarFrame::create(srcExtent).value();
     auto dstFrameNormed = tlct::io::YuvPlanarFrame::create(dstExtent).value();
     auto dstFrame = tlct::io::YuvPlanarFrame::create(dstExtent).value();
-    for ([[maybe_unused]] const int fid : rgs::views::iota(cliCfg.range.begin, cliCfg.range.end)) {
+    const auto fids = rgs::views::iota(cliCfg.range.begin, cliCfg.range.end) | rgs::views::stride(cliCfg.range.step);
+    for ([[maybe_unused]] const int fid : fids) {
+        if (fid != cliCfg.range.begin && cliCfg.range.step > 1) {
+            auto strideRes = yuvReader.skip(cliCfg.range.step - 1);
+            if (!strideRes) return std::unexpected{std::move(strideRes.error())};
+        }
+
         auto readRes = yuvReader.readInto(srcFrame);
         if (!readRes) return std::unexpected{std::move(readRes.error())};
 
@@ -150,9 +157,15 @@ static std::expected<void, tlct::Error> paint(const tlct::CliConfig& cliCfg, con
         writeRes = yuvWriter.write(dstFrameNormed);
         if (!writeRes) return std::unexpected{std::move(writeRes.error())};
 
-        cv::resize(srcFrame.getY(), dstFrame.getY(), {}, upsample, upsample, cv::INTER_CUBIC);
-        cv::resize(srcFrame.getU(), dstFrame.getU(), {}, upsample, upsample, cv::INTER_CUBIC);
-        cv::resize(srcFrame.getV(), dstFrame.getV(), {}, upsample, upsample, cv::INTER_CUBIC);
+        // The debug output is always 8bit
+        const double srcScale = 255.0 / ((1 << srcExtent.getBitDepth()) - 1);
+        cv::Mat u8Chan;
+        srcFrame.getY().convertTo(u8Chan, CV_8U, srcScale);
+        cv::resize(u8Chan, dstFrame.getY(), {}, upsample, upsample, cv::INTER_CUBIC);
+        srcFrame.getU().convertTo(u8Chan, CV_8U, srcScale);
+        cv::resize(u8Chan, dstFrame.getU(), {}, upsample, upsample, cv::INTER_CUBIC);
+        srcFrame.getV().convertTo(u8Chan, CV_8U, srcScale);
+        cv::resize(u8Chan, dstFrame.getV(), {}, upsample, upsample, cv::INTER_CUBIC);
         writeRes = yuvWriter.write(dstFrame);
         if (!writeRes) return std::unexpected{std::move(writeRes.error())};
     }
@@ -36,11 +36,12 @@ static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
         std::swap(mvSize.width, mvSize.height);
     }
 
-    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(srcSize.width, srcSize.height);
+    auto srcExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(srcSize.width, srcSize.height,
+                                                                 cliCfg.convert.bitDepth);
     if (!srcExtentRes) return std::unexpected{std::move(srcExtentRes.error())};
     auto srcExtent = srcExtentRes.value();
 
-    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p8bit(mvSize.width, mvSize.height);
+    auto mvExtentRes = tlct::io::YuvPlanarExtent::createYuv420p(mvSize.width, mvSize.height, cliCfg.convert.bitDepth);
     if (!mvExtentRes) return std::unexpected{std::move(mvExtentRes.error())};
     auto mvExtent = mvExtentRes.value();
 
@@ -50,25 +51,34 @@ static std::expected<void, tlct::Error> render(const tlct::CliConfig& cliCfg,
 
     const fs::path& dstdir = cliCfg.path.dst;
     fs::create_directories(dstdir);
+    auto bridgeWriterRes = manager.createBridgeWriter(dstdir / "bridge.bin",
+                                                      tlct::cvt::BridgeFileHeader::DEFAULT_KEYFRAME_INTERVAL);
+    if (!bridgeWriterRes) return std::unexpected{std::move(bridgeWriterRes.error())};
+    auto& bridgeWriter = bridgeWriterRes.value();
 
     auto skipRes = yuvReader.skip(cliCfg.range.begin);
     if (!skipRes) return std::unexpected{std::move(skipRes.error())};
 
     auto srcFrame = tlct::io::YuvPlanarFrame::create(srcExtent).value();
     auto mvFrame = tlct::io::YuvPlanarFrame::create(mvExtent).value();
-    for ([[maybe_unused]] const int fid : rgs::views::iota(cliCfg.range.begin, cliCfg.range.end)) {
+    const auto fids = rgs::views::iota(cliCfg.range.begin, cliCfg.range.end) | rgs::views::stride(cliCfg.range.step);
+    for ([[maybe_unused]] const int fid : fids) {
+        if (fid != cliCfg.range.begin && cliCfg.range.step > 1) {
+            auto strideRes = yuvReader.skip(cliCfg.range.step - 1);
+            if (!strideRes) return std::unexpected{std::move(strideRes.error())};
+        }
+
         auto readRes = yuvReader.readInto(srcFrame);
         if (!readRes) return std::unexpected{std::move(readRes.error())};
 
         auto updateRes = manager.update(srcFrame);
         if (!updateRes) return std::unexpected{std::move(updateRes.error())};
 
-        std::string filename = std::format("v{:03}.bin", fid);
-        fs::path psizePath = dstdir / filename;
-        manager.dumpBridge(psizePath) | unwrap;
+        auto dumpRes = manager.dumpBridge(bridgeWriter, fid);
+        if (!dumpRes) return std::unexpected{std::move(dumpRes.error())};
     }
 
-    return {};
+    return bridgeWriter.finish();
 }
 
 bool isMultiFocus(const tlct::ConfigMap& calibCfg) { return calibCfg.getOr<"NearFocalLenType">(-1) >= 0; }
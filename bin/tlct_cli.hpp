@@ -16,9 +16,30 @@
     parser->add_argument("calibFile").help("path of the `calib.cfg`").required();
 
     parser->add_group("I/O");
-    parser->add_argument("-i", "--src").help("input yuv420p file").required();
-    parser->add_argument("-o", "--dst").help("output directory").required();
+    parser->add_argument("-i", "--src")
+        .help("input yuv420p file, or y4m file if suffixed with `.y4m`, `-` to read yuv420p from stdin")
+        .required();
+    parser->add_argument("-o", "--dst")
+        .help("output directory, `-` to multiplex all views into stdout frame by frame")
+        .required();
     parser->add_argument("--debug").help("debug output directory").default_value("./debug");
+    parser->add_argument("--bitDepth")
+        .help("bit depth of the input and output yuv420p, samples above 8bit are stored as 16bit little-endian")
+        .scan<'i', int>()
+        .default_value(8);
+    parser->add_argument("--mmap").help("memory-map the input yuv420p file instead of streaming it").flag();
+    parser->add_argument("--y4m").help("write the views as y4m files instead of raw yuv420p").flag();
+    parser->add_argument("--mosaic")
+        .help("tile all views of a frame row-major into one frame, written to a single output")
+        .flag();
+    parser->add_argument("--prefetch")
+        .help("read ahead this many frames on a background thread, 0 to disable")
+        .scan<'i', int>()
+        .default_value(0);
+    parser->add_argument("--writeQueue")
+        .help("queue up to this many output frames for a background writer thread, 0 to disable")
+        .scan<'i', int>()
+        .default_value(0);
 
     parser->add_group("Frame Range");
     parser->add_argument("-b", "--begin")
@@ -29,6 +50,10 @@
         .help("the index of the end frame, right exclusive")
         .scan<'i', int>()
         .default_value(1);
+    parser->add_argument("--step")
+        .help("process every `step`-th frame in the range, the skipped frames are never read")
+        .scan<'i', int>()
+        .default_value(1);
 
     parser->add_group("Conversion - Basic");
     parser->add_argument("--views").help("viewpoint number").scan<'i', int>().default_value(1);
@@ -43,6 +68,10 @@
         .help("the input image will be upsampled by this scale")
         .scan<'i', int>()
         .default_value(1);
+    parser->add_argument("--directRender")
+        .help("render the views at output resolution by sampling the input at sub-pixel positions, "
+              "instead of rendering on the upsampled input")
+        .flag();
     parser->add_argument("--psizeInflate")
         .help("the extracted patch will be inflated by this scale")
         .scan<'g', float>()
@@ -65,13 +94,19 @@
     const argparse::ArgumentParser& parser) noexcept {
     const tlct::CliConfig::Path path{parser.get<std::string>("--src"), parser.get<std::string>("--dst"),
                                      parser.get<std::string>("--debug")};
-    const tlct::CliConfig::Range range{parser.get<int>("--begin"), parser.get<int>("--end")};
+    const tlct::CliConfig::Range range{parser.get<int>("--begin"), parser.get<int>("--end"),
+                                       parser.get<int>("--step")};
     const tlct::CliConfig::Convert convert{parser.get<int>("--views"),
                                            parser.get<float>("--resize"),
                                            parser.get<int>("--method"),
                                            parser.get<int>("--upsample"),
+                                           parser.get<bool>("--directRender"),
                                            parser.get<float>("--psizeInflate"),
                                            parser.get<float>("--viewShiftRange"),
-                                           parser.get<float>("--psizeShortcutThreshold")};
-    return tlct::CliConfig::create(path, range, convert);
+                                           parser.get<float>("--psizeShortcutThreshold"),
+                                           parser.get<int>("--bitDepth")};
+    const tlct::CliConfig::IO io{parser.get<bool>("--mmap"), parser.get<int>("--prefetch"),
+                                 parser.get<int>("--writeQueue"), parser.get<bool>("--y4m"),
+                                 parser.get<bool>("--mosaic")};
+    return tlct::CliConfig::create(path, range, convert, io);
 }
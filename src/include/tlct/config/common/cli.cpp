@@ -8,16 +8,21 @@
 
 namespace tlct::_cfg {
 
-CliConfig::CliConfig(Path&& path, const Range& range, const Convert& convert) noexcept
-    : path(std::move(path)), range(range), convert(convert) {}
+CliConfig::CliConfig(Path&& path, const Range& range, const Convert& convert, const IO& io) noexcept
+    : path(std::move(path)), range(range), convert(convert), io(io) {}
 
-std::expected<CliConfig, Error> CliConfig::create(const Path& path, const Range& range,
-                                                  const Convert& convert) noexcept {
+std::expected<CliConfig, Error> CliConfig::create(const Path& path, const Range& range, const Convert& convert,
+                                                  const IO& io) noexcept {
     if (range.end <= range.begin) [[unlikely]] {
         auto errMsg = std::format("expect range.end > range.begin, got: {} <= {}", range.end, range.begin);
         return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
     }
 
+    if (range.step <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect range.step > 0, got: {}", range.step);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
     if (convert.method < 0) [[unlikely]] {
         auto errMsg = std::format("expect method >= 0, got: {}", convert.method);
         return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
@@ -43,8 +48,28 @@ std::expected<CliConfig, Error> CliConfig::create(const Path& path, const Range&
         return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
     }
 
+    if (convert.bitDepth < 8 || convert.bitDepth > 16) [[unlikely]] {
+        auto errMsg = std::format("expect 8 <= bitDepth <= 16, got: {}", convert.bitDepth);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (io.mmap && path.src == "-") [[unlikely]] {
+        auto errMsg = std::format("cannot memory-map stdin");
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (io.prefetch < 0) [[unlikely]] {
+        auto errMsg = std::format("expect prefetch >= 0, got: {}", io.prefetch);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (io.writeQueue < 0) [[unlikely]] {
+        auto errMsg = std::format("expect writeQueue >= 0, got: {}", io.writeQueue);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
     auto copiedPath = path;
-    return CliConfig{std::move(copiedPath), range, convert};
+    return CliConfig{std::move(copiedPath), range, convert, io};
 }
 
 }  // namespace tlct::_cfg
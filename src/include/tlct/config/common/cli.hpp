@@ -20,6 +20,7 @@ public:
     struct Range {
         int begin;
         int end;
+        int step;
     };
 
     struct Convert {
@@ -27,20 +28,31 @@ public:
         float resize;
         int method;
         int upsample;
+        bool directRender;
         float psizeInflate;
         float viewShiftRange;
         float psizeShortcutThreshold;
+        int bitDepth;
+    };
+
+    struct IO {
+        bool mmap;
+        int prefetch;
+        int writeQueue;
+        bool y4m;
+        bool mosaic;
     };
 
     Path path;
     Range range;
     Convert convert;
+    IO io;
 
     [[nodiscard]] TLCT_API static std::expected<CliConfig, Error> create(const Path& path, const Range& range,
-                                                                         const Convert& convert) noexcept;
+                                                                         const Convert& convert, const IO& io) noexcept;
 
 private:
-    CliConfig(Path&& path, const Range& range, const Convert& convert) noexcept;
+    CliConfig(Path&& path, const Range& range, const Convert& convert, const IO& io) noexcept;
 };
 
 }  // namespace tlct::_cfg
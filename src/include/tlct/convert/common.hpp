@@ -2,3 +2,13 @@
 
 #include "tlct/convert/common/bridge.hpp"
 #include "tlct/convert/common/cache.hpp"
+
+namespace tlct::cvt {
+
+namespace _ = _cvt;
+
+using _::BridgeFileHeader;
+using _::BridgeFileReader_;
+using _::BridgeFileWriter_;
+
+}  // namespace tlct::cvt
@@ -1,3 +1,4 @@
 #pragma once
 
+#include "tlct/convert/common/bridge/container.hpp"
 #include "tlct/convert/common/bridge/patch_merge.hpp"
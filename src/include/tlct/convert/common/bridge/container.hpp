@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <vector>
+
+#include "tlct/config/common.hpp"
+#include "tlct/config/concepts.hpp"
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/mmap.hpp"
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_cvt {
+
+namespace fs = std::filesystem;
+namespace rgs = std::ranges;
+
+static_assert(std::endian::native == std::endian::little, "the bridge container is stored little-endian");
+
+// Layout: `BridgeFileHeader | frame payloads... | BridgeFileIndexEntry[frameCount]`.
+// Patch sizes and weights are stored in fixed point, one zigzag varint per MI. Each frame is a delta against the
+// previous one, except keyframes which are deltas against zero, so a seek decodes at most `keyframeInterval` frames.
+struct BridgeFileHeader {
+    static constexpr std::array<char, 8> MAGIC{'T', 'L', 'C', 'T', 'B', 'R', 'G', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int PSIZE_FRAC_BITS = 8;
+    static constexpr int WEIGHT_FRAC_BITS = 16;
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 32;
+
+    static constexpr uint32_t FLAG_DIRECTION = 1 << 0;
+    static constexpr uint32_t FLAG_KEPLER = 1 << 1;
+    static constexpr uint32_t FLAG_MULTI_FOCUS = 1 << 2;
+    static constexpr uint32_t FLAG_OUT_SHIFT = 1 << 3;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t headerSize;
+    // Arrange geometry, after upsampling
+    int32_t imgWidth;
+    int32_t imgHeight;
+    float diameter;
+    int32_t upsample;
+    int32_t miRows;
+    int32_t miMaxCols;
+    uint32_t arrangeFlags;
+    // Patch size estimation config
+    int32_t method;
+    float psizeShortcutThreshold;
+    // Sequence
+    uint32_t keyframeInterval;
+    uint32_t frameCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+};
+static_assert(sizeof(BridgeFileHeader) == 72);
+
+struct BridgeFileIndexEntry {
+    uint64_t offset;
+    int32_t fid;
+    uint32_t size;
+};
+static_assert(sizeof(BridgeFileIndexEntry) == 16);
+
+template <cfg::concepts::CArrange TArrange>
+[[nodiscard]] BridgeFileHeader makeBridgeFileHeader(const TArrange& arrange, const cfg::CliConfig::Convert& cvtCfg,
+                                                    int keyframeInterval) noexcept {
+    uint32_t arrangeFlags = 0;
+    if (arrange.getDirection()) arrangeFlags |= BridgeFileHeader::FLAG_DIRECTION;
+    if (arrange.isKepler()) arrangeFlags |= BridgeFileHeader::FLAG_KEPLER;
+    if (arrange.isMultiFocus()) arrangeFlags |= BridgeFileHeader::FLAG_MULTI_FOCUS;
+    if (arrange.isOutShift()) arrangeFlags |= BridgeFileHeader::FLAG_OUT_SHIFT;
+
+    return {
+        .magic = BridgeFileHeader::MAGIC,
+        .version = BridgeFileHeader::VERSION,
+        .headerSize = sizeof(BridgeFileHeader),
+        .imgWidth = arrange.getImgWidth(),
+        .imgHeight = arrange.getImgHeight(),
+        .diameter = arrange.getDiameter(),
+        .upsample = arrange.getUpsample(),
+        .miRows = arrange.getMIRows(),
+        .miMaxCols = arrange.getMIMaxCols(),
+        .arrangeFlags = arrangeFlags,
+        .method = cvtCfg.method,
+        .psizeShortcutThreshold = cvtCfg.psizeShortcutThreshold,
+        .keyframeInterval = (uint32_t)keyframeInterval,
+        .frameCount = 0,
+        .reserved = 0,
+        .indexOffset = 0,
+    };
+}
+
+[[nodiscard]] inline int32_t toFixedPoint(float v, int fracBits) noexcept {
+    // A psize of 0/0 is NaN, which no integer represents
+    if (!std::isfinite(v)) [[unlikely]] {
+        return 0;
+    }
+    const double scaled = std::round((double)v * (double)(1 << fracBits));
+    return (int32_t)std::clamp(scaled, (double)std::numeric_limits<int32_t>::min(),
+                               (double)std::numeric_limits<int32_t>::max());
+}
+
+[[nodiscard]] inline float fromFixedPoint(int32_t v, int fracBits) noexcept {
+    return (float)((double)v / (double)(1 << fracBits));
+}
+
+[[nodiscard]] inline uint32_t zigzagEncode(int32_t v) noexcept { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+
+[[nodiscard]] inline int32_t zigzagDecode(uint32_t u) noexcept { return (int32_t)(u >> 1) ^ -(int32_t)(u & 1); }
+
+inline void putVarint(std::vector<uint8_t>& buffer, uint32_t u) {
+    while (u >= 0x80) {
+        buffer.push_back((uint8_t)(u | 0x80));
+        u >>= 7;
+    }
+    buffer.push_back((uint8_t)u);
+}
+
+[[nodiscard]] inline bool getVarint(const uint8_t*& ptr, const uint8_t* end, uint32_t& u) noexcept {
+    u = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (ptr == end) return false;
+        const uint8_t byte = *ptr++;
+        u |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// Visit the offsets of all valid MIs in storage order
+template <cfg::concepts::CArrange TArrange, typename TFunc>
+void forEachMIOffset(const TArrange& arrange, TFunc&& func) noexcept {
+    for (const int row : rgs::views::iota(0, arrange.getMIRows())) {
+        const int rowOffset = row * arrange.getMIMaxCols();
+        for (const int col : rgs::views::iota(0, arrange.getMICols(row))) {
+            func(rowOffset + col);
+        }
+    }
+}
+
+template <typename TBridge_>
+class BridgeFileWriter_ {
+public:
+    // Typename alias
+    using TBridge = TBridge_;
+    using TArrange = TBridge::TArrange;
+
+private:
+    BridgeFileWriter_(std::ofstream&& ofs, const TArrange& arrange, const BridgeFileHeader& header,
+                      std::vector<int32_t>&& prevPsizes, std::vector<int32_t>&& prevWeights) noexcept;
+
+public:
+    // Constructor
+    BridgeFileWriter_() = delete;
+    BridgeFileWriter_(const BridgeFileWriter_& rhs) = delete;
+    BridgeFileWriter_& operator=(const BridgeFileWriter_& rhs) = delete;
+    BridgeFileWriter_(BridgeFileWriter_&& rhs) noexcept = default;
+    BridgeFileWriter_& operator=(BridgeFileWriter_&& rhs) noexcept = default;
+    // Finishes the container if `finish` has not been called
+    ~BridgeFileWriter_() noexcept;
+
+    // Initialize from
+    [[nodiscard]] static std::expected<BridgeFileWriter_, Error> create(const fs::path& fpath,
+                                                                        const TArrange& arrange,
+                                                                        const cfg::CliConfig::Convert& cvtCfg,
+                                                                        int keyframeInterval) noexcept;
+
+    // Non-const methods
+    // `fid` must be strictly increasing across calls
+    [[nodiscard]] std::expected<void, Error> write(int fid, const TBridge& bridge) noexcept;
+    // Append the frame index and patch the header. No more frames can be written afterwards.
+    [[nodiscard]] std::expected<void, Error> finish() noexcept;
+
+private:
+    std::ofstream ofs_;
+    TArrange arrange_;
+    BridgeFileHeader header_;
+    std::vector<BridgeFileIndexEntry> index_;
+    std::vector<int32_t> prevPsizes_;
+    std::vector<int32_t> prevWeights_;
+    std::vector<uint8_t> buffer_;
+};
+
+template <typename TBridge>
+BridgeFileWriter_<TBridge>::BridgeFileWriter_(std::ofstream&& ofs, const TArrange& arrange,
+                                              const BridgeFileHeader& header, std::vector<int32_t>&& prevPsizes,
+                                              std::vector<int32_t>&& prevWeights) noexcept
+    : ofs_(std::move(ofs)),
+      arrange_(arrange),
+      header_(header),
+      prevPsizes_(std::move(prevPsizes)),
+      prevWeights_(std::move(prevWeights)) {}
+
+template <typename TBridge>
+BridgeFileWriter_<TBridge>::~BridgeFileWriter_() noexcept {
+    if (ofs_.is_open()) {
+        [[maybe_unused]] auto _ = finish();
+    }
+}
+
+template <typename TBridge>
+auto BridgeFileWriter_<TBridge>::create(const fs::path& fpath, const TArrange& arrange,
+                                        const cfg::CliConfig::Convert& cvtCfg, int keyframeInterval) noexcept
+    -> std::expected<BridgeFileWriter_, Error> {
+    if (keyframeInterval <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect keyframeInterval > 0, got: {}", keyframeInterval);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    std::ofstream ofs{fpath, std::ios::binary};
+    if (!ofs.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to open file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
+    }
+
+    // Patched by `finish`
+    const BridgeFileHeader header = makeBridgeFileHeader(arrange, cvtCfg, keyframeInterval);
+    ofs.write((const char*)&header, sizeof(header));
+    if (!ofs.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write header. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
+    }
+
+    std::vector<int32_t> prevPsizes;
+    std::vector<int32_t> prevWeights;
+    try {
+        const size_t miCount = (size_t)arrange.getMIRows() * arrange.getMIMaxCols();
+        prevPsizes.resize(miCount);
+        if (arrange.isMultiFocus()) {
+            prevWeights.resize(miCount);
+        }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    return BridgeFileWriter_{std::move(ofs), arrange, header, std::move(prevPsizes), std::move(prevWeights)};
+}
+
+template <typename TBridge>
+std::expected<void, Error> BridgeFileWriter_<TBridge>::write(int fid, const TBridge& bridge) noexcept {
+    if (!ofs_.is_open()) [[unlikely]] {
+        auto errMsg = std::format("the bridge container has been finished");
+        return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, std::move(errMsg)}};
+    }
+
+    if (!index_.empty() && fid <= index_.back().fid) [[unlikely]] {
+        auto errMsg = std::format("expect increasing fid, got {} after {}", fid, index_.back().fid);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    const bool isKeyframe = index_.size() % header_.keyframeInterval == 0;
+    if (isKeyframe) {
+        rgs::fill(prevPsizes_, 0);
+        rgs::fill(prevWeights_, 0);
+    }
+
+    try {
+        buffer_.clear();
+        forEachMIOffset(arrange_, [&](int offset) {
+            const int32_t psize = toFixedPoint(bridge.getPatchsize(offset), BridgeFileHeader::PSIZE_FRAC_BITS);
+            putVarint(buffer_, zigzagEncode(psize - prevPsizes_[offset]));
+            prevPsizes_[offset] = psize;
+        });
+        if (arrange_.isMultiFocus()) {
+            forEachMIOffset(arrange_, [&](int offset) {
+                const int32_t weight = toFixedPoint(bridge.getWeight(offset), BridgeFileHeader::WEIGHT_FRAC_BITS);
+                putVarint(buffer_, zigzagEncode(weight - prevWeights_[offset]));
+                prevWeights_[offset] = weight;
+            });
+        }
+
+        const uint64_t offset = (uint64_t)ofs_.tellp();
+        index_.push_back({offset, fid, (uint32_t)buffer_.size()});
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    ofs_.write((const char*)buffer_.data(), (std::streamsize)buffer_.size());
+    if (!ofs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write bridge of frame {}", fid);
+        return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+    }
+
+    return {};
+}
+
+template <typename TBridge>
+std::expected<void, Error> BridgeFileWriter_<TBridge>::finish() noexcept {
+    if (!ofs_.is_open()) [[unlikely]] {
+        auto errMsg = std::format("the bridge container has been finished");
+        return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, std::move(errMsg)}};
+    }
+
+    header_.frameCount = (uint32_t)index_.size();
+    header_.indexOffset = (uint64_t)ofs_.tellp();
+    ofs_.write((const char*)index_.data(), (std::streamsize)(index_.size() * sizeof(BridgeFileIndexEntry)));
+    ofs_.seekp(0);
+    ofs_.write((const char*)&header_, sizeof(header_));
+    const bool good = ofs_.good();
+    const auto state = ofs_.rdstate();
+    ofs_.close();
+
+    if (!good) [[unlikely]] {
+        auto errMsg = std::format("failed to write the frame index");
+        return std::unexpected{Error{ECate::eSys, state, std::move(errMsg)}};
+    }
+
+    return {};
+}
+
+template <typename TBridge_>
+class BridgeFileReader_ {
+public:
+    // Typename alias
+    using TBridge = TBridge_;
+    using TArrange = TBridge::TArrange;
+
+private:
+    BridgeFileReader_(_hp::MmapFile&& file, const TArrange& arrange, const BridgeFileHeader& header,
+                      std::vector<BridgeFileIndexEntry>&& index, std::vector<int32_t>&& psizes,
+                      std::vector<int32_t>&& weights) noexcept;
+
+public:
+    // Constructor
+    BridgeFileReader_() = delete;
+    BridgeFileReader_(const BridgeFileReader_& rhs) = delete;
+    BridgeFileReader_& operator=(const BridgeFileReader_& rhs) = delete;
+    BridgeFileReader_(BridgeFileReader_&& rhs) noexcept = default;
+    BridgeFileReader_& operator=(BridgeFileReader_&& rhs) noexcept = default;
+
+    // Initialize from
+    // Fails if the container was produced for another arrange
+    [[nodiscard]] static std::expected<BridgeFileReader_, Error> create(const fs::path& fpath,
+                                                                        const TArrange& arrange) noexcept;
+
+    // Const methods
+    [[nodiscard]] const BridgeFileHeader& getHeader() const noexcept { return header_; }
+    [[nodiscard]] int getFrameCount() const noexcept { return (int)index_.size(); }
+
+    // Non-const methods
+    // Sequential reads decode a single delta frame
+    [[nodiscard]] std::expected<void, Error> readInto(int fid, TBridge& bridge) noexcept;
+
+private:
+    [[nodiscard]] std::expected<void, Error> decode(size_t pos) noexcept;
+
+    _hp::MmapFile file_;
+    TArrange arrange_;
+    BridgeFileHeader header_;
+    std::vector<BridgeFileIndexEntry> index_;
+    std::vector<int32_t> psizes_;
+    std::vector<int32_t> weights_;
+    size_t decodedPos_;
+};
+
+template <typename TBridge>
+BridgeFileReader_<TBridge>::BridgeFileReader_(_hp::MmapFile&& file, const TArrange& arrange,
+                                              const BridgeFileHeader& header,
+                                              std::vector<BridgeFileIndexEntry>&& index, std::vector<int32_t>&& psizes,
+                                              std::vector<int32_t>&& weights) noexcept
+    : file_(std::move(file)),
+      arrange_(arrange),
+      header_(header),
+      index_(std::move(index)),
+      psizes_(std::move(psizes)),
+      weights_(std::move(weights)),
+      decodedPos_(std::numeric_limits<size_t>::max()) {}
+
+template <typename TBridge>
+auto BridgeFileReader_<TBridge>::create(const fs::path& fpath, const TArrange& arrange) noexcept
+    -> std::expected<BridgeFileReader_, Error> {
+    auto fileRes = _hp::MmapFile::createReadOnly(fpath);
+    if (!fileRes) [[unlikely]] {
+        return std::unexpected{std::move(fileRes.error())};
+    }
+    auto& file = fileRes.value();
+
+    BridgeFileHeader header;
+    if (file.getSize() < sizeof(header)) [[unlikely]] {
+        auto errMsg = std::format("bridge container too small. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    if (header.magic != BridgeFileHeader::MAGIC || header.headerSize != sizeof(header)) [[unlikely]] {
+        auto errMsg = std::format("not a bridge container. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (header.version != BridgeFileHeader::VERSION) [[unlikely]] {
+        auto errMsg = std::format("unsupported bridge container version {}, expect {}", header.version,
+                                  BridgeFileHeader::VERSION);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eNoSupport, std::move(errMsg)}};
+    }
+
+    // The config fields are informative, only the geometry has to match
+    const BridgeFileHeader expected = makeBridgeFileHeader(arrange, {}, 1);
+    if (header.imgWidth != expected.imgWidth || header.imgHeight != expected.imgHeight ||
+        header.diameter != expected.diameter || header.upsample != expected.upsample ||
+        header.miRows != expected.miRows || header.miMaxCols != expected.miMaxCols ||
+        header.arrangeFlags != expected.arrangeFlags) [[unlikely]] {
+        auto errMsg = std::format("bridge container was produced for another arrange. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    const uint64_t indexSize = (uint64_t)header.frameCount * sizeof(BridgeFileIndexEntry);
+    // Checked without sums, which a corrupted offset may wrap
+    if (header.keyframeInterval == 0 || header.indexOffset < sizeof(header) || header.indexOffset > file.getSize() ||
+        indexSize != file.getSize() - header.indexOffset) [[unlikely]] {
+        auto errMsg = std::format("truncated or unfinished bridge container. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    std::vector<BridgeFileIndexEntry> index;
+    std::vector<int32_t> psizes;
+    std::vector<int32_t> weights;
+    try {
+        index.resize(header.frameCount);
+        const size_t miCount = (size_t)arrange.getMIRows() * arrange.getMIMaxCols();
+        psizes.resize(miCount);
+        if (arrange.isMultiFocus()) {
+            weights.resize(miCount);
+        }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+    std::memcpy(index.data(), file.getData() + header.indexOffset, indexSize);
+
+    for (const auto& entry : index) {
+        if (entry.offset < sizeof(header) || entry.offset > header.indexOffset ||
+            entry.size > header.indexOffset - entry.offset) [[unlikely]] {
+            auto errMsg = std::format("corrupted index entry of frame {}. path={}", entry.fid, fpath.string());
+            return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+        }
+    }
+
+    file.adviseWillNeed(sizeof(header), header.indexOffset - sizeof(header));
+
+    return BridgeFileReader_{std::move(file),     arrange, header, std::move(index), std::move(psizes),
+                             std::move(weights)};
+}
+
+template <typename TBridge>
+std::expected<void, Error> BridgeFileReader_<TBridge>::decode(size_t pos) noexcept {
+    if (pos % header_.keyframeInterval == 0) {
+        rgs::fill(psizes_, 0);
+        rgs::fill(weights_, 0);
+    }
+
+    const auto& entry = index_[pos];
+    const uint8_t* ptr = (const uint8_t*)file_.getData() + entry.offset;
+    const uint8_t* end = ptr + entry.size;
+
+    bool ok = true;
+    forEachMIOffset(arrange_, [&](int offset) {
+        uint32_t u = 0;
+        ok = ok && getVarint(ptr, end, u);
+        psizes_[offset] += zigzagDecode(u);
+    });
+    if (arrange_.isMultiFocus()) {
+        forEachMIOffset(arrange_, [&](int offset) {
+            uint32_t u = 0;
+            ok = ok && getVarint(ptr, end, u);
+            weights_[offset] += zigzagDecode(u);
+        });
+    }
+
+    if (!ok || ptr != end) [[unlikely]] {
+        decodedPos_ = std::numeric_limits<size_t>::max();
+        auto errMsg = std::format("corrupted bridge of frame {}", entry.fid);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    decodedPos_ = pos;
+    return {};
+}
+
+template <typename TBridge>
+std::expected<void, Error> BridgeFileReader_<TBridge>::readInto(int fid, TBridge& bridge) noexcept {
+    const auto it = rgs::lower_bound(index_, fid, {}, &BridgeFileIndexEntry::fid);
+    if (it == index_.end() || it->fid != fid) [[unlikely]] {
+        auto errMsg = std::format("frame {} is not in the bridge container", fid);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    const size_t pos = it - index_.begin();
+
+    if (pos != decodedPos_) {
+        const size_t keyframePos = pos - pos % header_.keyframeInterval;
+        // Continue from the last decoded frame when it lies between the keyframe and the target
+        size_t beginPos = keyframePos;
+        if (decodedPos_ != std::numeric_limits<size_t>::max() && decodedPos_ >= keyframePos && decodedPos_ < pos) {
+            beginPos = decodedPos_ + 1;
+        }
+
+        for (size_t decodePos = beginPos; decodePos <= pos; decodePos++) {
+            auto decodeRes = decode(decodePos);
+            if (!decodeRes) [[unlikely]] {
+                return std::unexpected{std::move(decodeRes.error())};
+            }
+        }
+    }
+
+    forEachMIOffset(arrange_, [&](int offset) {
+        bridge.getInfo(offset).setPatchsize(fromFixedPoint(psizes_[offset], BridgeFileHeader::PSIZE_FRAC_BITS));
+    });
+    if (arrange_.isMultiFocus()) {
+        forEachMIOffset(arrange_, [&](int offset) {
+            bridge.setWeight(offset, fromFixedPoint(weights_[offset], BridgeFileHeader::WEIGHT_FRAC_BITS));
+        });
+    }
+
+    return {};
+}
+
+}  // namespace tlct::_cvt
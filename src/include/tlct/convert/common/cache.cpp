@@ -4,6 +4,8 @@
 
 #include "tlct/config/arrange.hpp"
 #include "tlct/config/concepts.hpp"
+#include "tlct/convert/helper/functional.hpp"
+#include "tlct/convert/helper/resample.hpp"
 #include "tlct/helper/error.hpp"
 #include "tlct/helper/std.hpp"
 
@@ -16,46 +18,62 @@ namespace tlct::_cvt {
 namespace rgs = std::ranges;
 
 template <cfg::concepts::CArrange TArrange>
-CommonCache_<TArrange>::CommonCache_(const TArrange& arrange) noexcept : arrange_(arrange) {}
+CommonCache_<TArrange>::CommonCache_(const TArrange& arrange, const bool directRender) noexcept
+    : arrange_(arrange), directRender_(directRender) {}
 
 template <cfg::concepts::CArrange TArrange>
-auto CommonCache_<TArrange>::create(const TArrange& arrange) noexcept -> std::expected<CommonCache_, Error> {
+auto CommonCache_<TArrange>::create(const TArrange& arrange, const bool directRender) noexcept
+    -> std::expected<CommonCache_, Error> {
     // TODO: the memory alloc should be moved here
-    return {arrange};
+    return CommonCache_{arrange, directRender};
 }
 
 template <cfg::concepts::CArrange TArrange>
 std::expected<void, Error> CommonCache_<TArrange>::update(const io::YuvPlanarFrame& src) noexcept {
     try {
-        src.getY().copyTo(rawSrcs[0]);
-        src.getU().copyTo(rawSrcs[1]);
-        src.getV().copyTo(rawSrcs[2]);
+        // Only shallow references here. Neither `resize` nor `transposeResize` writes back,
+        // so the source frame is left untouched.
+        // This allows `src` to be a read-only view, e.g. from `YuvPlanarMmapReader`.
+        rawSrcs[0] = src.getY();
+        rawSrcs[1] = src.getU();
+        rawSrcs[2] = src.getV();
 
-        if (arrange_.getDirection()) {
-            for (const int i : rgs::views::iota(0, CHANNELS)) {
-                cv::transpose(rawSrcs[i], rawSrcs[i]);
-            }
-        }
+        shifts = {0, src.getExtent().getUShift(), src.getExtent().getVShift()};
 
+        // Chroma stays on its own subsampled grid, the renderer scales the MI geometry instead
         const int upsample = arrange_.getUpsample();
-        if (upsample != 1) [[likely]] {
-            cv::resize(rawSrcs[0], srcs[0], {}, upsample, upsample, cv::INTER_CUBIC);
-        } else {
-            srcs[0] = rawSrcs[0];
-        }
+        for (const int i : rgs::views::iota(0, CHANNELS)) {
+            if (directRender_) {
+                // The renderers sample the native resolution planes, no need to upsample the chroma ones.
+                // Neither to transpose them, the patches are sampled at transposed positions instead.
+                rawSrcs[i].convertTo(f32Srcs[i], CV_32FC1);
+                if (i != 0) {
+                    srcs[i].release();
+                    continue;
+                }
+            }
 
-        if (src.getExtent().getUShift() != 0) {
-            const int uUpsample = upsample << src.getExtent().getUShift();
-            cv::resize(rawSrcs[1], srcs[1], {}, uUpsample, uUpsample, cv::INTER_CUBIC);
-        } else {
-            srcs[1] = rawSrcs[1];
-        }
+            if (arrange_.getDirection()) {
+                if (upsample != 1) [[likely]] {
+                    // The transpose is folded into the upsampling, which keeps it to one pass per plane
+                    const cv::Size dstSize{rawSrcs[i].rows * upsample, rawSrcs[i].cols * upsample};
+                    transposeResize(rawSrcs[i], srcs[i], dstSize);
+                } else if (directRender_) {
+                    cv::transpose(rawSrcs[i], srcs[i]);
+                } else {
+                    // Nothing to fold the transpose into, so it is fused with the conversion instead
+                    transposeConvert(rawSrcs[i], srcs[i], f32Srcs[i]);
+                    continue;
+                }
+            } else if (upsample != 1) [[likely]] {
+                cv::resize(rawSrcs[i], srcs[i], {}, upsample, upsample, cv::INTER_CUBIC);
+            } else {
+                srcs[i] = rawSrcs[i];
+            }
 
-        if (src.getExtent().getVShift() != 0) {
-            const int vUpsample = upsample << src.getExtent().getVShift();
-            cv::resize(rawSrcs[2], srcs[2], {}, vUpsample, vUpsample, cv::INTER_CUBIC);
-        } else {
-            srcs[2] = rawSrcs[2];
+            if (!directRender_) {
+                srcs[i].convertTo(f32Srcs[i], CV_32FC1);
+            }
         }
     } catch (const std::bad_alloc&) {
         return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
@@ -23,19 +23,28 @@ public:
     CommonCache_() noexcept = default;
     CommonCache_(CommonCache_&& rhs) noexcept = default;
     CommonCache_& operator=(CommonCache_&& rhs) noexcept = default;
-    CommonCache_(const TArrange& arrange) noexcept;
+    CommonCache_(const TArrange& arrange, bool directRender) noexcept;
 
     // Initialize from
-    [[nodiscard]] TLCT_API static std::expected<CommonCache_, Error> create(const TArrange& arrange) noexcept;
+    [[nodiscard]] TLCT_API static std::expected<CommonCache_, Error> create(const TArrange& arrange,
+                                                                            bool directRender) noexcept;
 
     // Non-const methods
     [[nodiscard]] TLCT_API std::expected<void, Error> update(const io::YuvPlanarFrame& src) noexcept;
 
     TChannels rawSrcs;
+    // Upsampled planes. In direct render mode only the luma one is kept, for the patch size estimation.
     TChannels srcs;
+    // `CV_32FC1` planes for the renderers, shared by every view of the frame.
+    // They are copies of `srcs`, or of `rawSrcs` in direct render mode, which keep the native orientation
+    // even when the arrange is transposed.
+    TChannels f32Srcs;
+    // Subsampling of each plane in `srcs` relative to the luma one
+    std::array<int, CHANNELS> shifts{};
 
 private:
     TArrange arrange_;
+    bool directRender_ = false;
 };
 
 }  // namespace tlct::_cvt
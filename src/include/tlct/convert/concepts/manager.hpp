@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <span>
 
 #include <opencv2/core.hpp>
 
@@ -40,6 +41,12 @@ concept CManager = requires {
     requires requires(Self self, io::YuvPlanarFrame& dst, int viewRow, int viewCol) {
         self.renderInto(dst, viewRow, viewCol);
     };
+    requires requires(Self self, io::YuvPlanarFrame& dst, int viewRow, int viewCol, cv::Rect roi) {
+        self.renderInto(dst, viewRow, viewCol, roi);
+    };
+    requires requires(Self self, std::span<io::YuvPlanarFrame> dsts, std::span<const cv::Point> viewIndices) {
+        self.renderViews(dsts, viewIndices);
+    };
 };
 
 }  // namespace tlct::_cvt::concepts
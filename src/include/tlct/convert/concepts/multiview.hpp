@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <span>
 
 #include <opencv2/core.hpp>
 
@@ -29,10 +30,23 @@ concept CMvImpl = requires {
         { self.getOutputSize() } -> std::same_as<cv::Size>;
     };
 
+    requires requires(const Self self) {
+        { self.createCache() } -> std::same_as<std::expected<typename Self::TMvCache, Error>>;
+    };
+
     requires CBridge<TBridge>;
-    requires requires(const Self self, const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow, int viewCol) {
+    requires requires(const Self self, const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow, int viewCol,
+                      typename Self::TMvCache& cache) {
         self.renderView(bridge, dst, viewRow, viewCol);
+        self.renderView(bridge, dst, viewRow, viewCol, cache);
     };
+    requires requires(const Self self, const TBridge& bridge, std::span<io::YuvPlanarFrame> dsts,
+                      std::span<const cv::Point> viewIndices, std::span<typename Self::TMvCache> caches) {
+        self.renderViews(bridge, dsts, viewIndices, caches);
+    };
+} && requires {
+    // Non-const methods
+    requires requires(Self self, const TBridge& bridge) { self.updateWeights(bridge); };
 };
 
 }  // namespace tlct::_cvt::concepts
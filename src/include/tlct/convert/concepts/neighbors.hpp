@@ -27,6 +27,7 @@ concept CNeighbors = requires {
         { self.getNeighborIdx(direction) } noexcept -> std::same_as<cv::Point>;
         { self.getNeighborPt(direction) } noexcept -> std::same_as<cv::Point2f>;
         { self.getUnitShift(direction) } noexcept -> std::same_as<cv::Point2f>;
+        { self.getOppositeDirection(direction) } noexcept -> std::same_as<typename Self::Direction>;
     };
 };
 
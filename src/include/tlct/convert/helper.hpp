@@ -1,4 +1,7 @@
 #pragma once
 
 #include "tlct/convert/helper/functional.hpp"
+#include "tlct/convert/helper/mask_bank.hpp"
+#include "tlct/convert/helper/patch_blender.hpp"
+#include "tlct/convert/helper/resample.hpp"
 #include "tlct/convert/helper/roi.hpp"
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <ranges>
 
@@ -49,11 +51,14 @@ float computeGrads(const cv::Mat& src) noexcept {
 
     float grads = 0.0;
 
-    cv::Sobel(src, edges, CV_16S, 1, 0);
+    // 16bit samples may overflow `CV_16S`
+    const int ddepth = src.depth() == CV_16U ? CV_32F : CV_16S;
+
+    cv::Sobel(src, edges, ddepth, 1, 0);
     edges = cv::abs(edges);
     grads += (float)cv::sum(edges)[0];
 
-    cv::Sobel(src, edges, CV_16S, 0, 1);
+    cv::Sobel(src, edges, ddepth, 0, 1);
     edges = cv::abs(edges);
     grads += (float)cv::sum(edges)[0];
 
@@ -78,4 +83,35 @@ void computeGradsMap(const cv::Mat& src, cv::Mat& dst) noexcept {
     cv::GaussianBlur(grads, dst, {kSize, kSize}, sigma);
 }
 
+// Square tiles keep both the rows read and the rows written in cache
+template <typename T>
+static void transposeConvertImpl(const cv::Mat& src, cv::Mat& dst, cv::Mat& f32Dst) {
+    constexpr int TILE = 32;
+
+    dst.create(src.cols, src.rows, src.type());
+    f32Dst.create(src.cols, src.rows, CV_32FC1);
+
+    for (int rowBegin = 0; rowBegin < src.rows; rowBegin += TILE) {
+        const int rowEnd = std::min(rowBegin + TILE, src.rows);
+        for (int colBegin = 0; colBegin < src.cols; colBegin += TILE) {
+            const int colEnd = std::min(colBegin + TILE, src.cols);
+            for (const int row : rgs::views::iota(rowBegin, rowEnd)) {
+                const T* psrc = src.ptr<T>(row);
+                for (const int col : rgs::views::iota(colBegin, colEnd)) {
+                    dst.ptr<T>(col)[row] = psrc[col];
+                    f32Dst.ptr<float>(col)[row] = (float)psrc[col];
+                }
+            }
+        }
+    }
+}
+
+void transposeConvert(const cv::Mat& src, cv::Mat& dst, cv::Mat& f32Dst) {
+    if (src.depth() == CV_8U) {
+        transposeConvertImpl<uint8_t>(src, dst, f32Dst);
+    } else {
+        transposeConvertImpl<uint16_t>(src, dst, f32Dst);
+    }
+}
+
 }  // namespace tlct::_cvt
@@ -14,6 +14,9 @@ namespace rgs = std::ranges;
 
 TLCT_API void computeGradsMap(const cv::Mat& src, cv::Mat& dst) noexcept;
 
+// Equals `transpose(src, dst)` followed by `dst.convertTo(f32Dst, CV_32FC1)`, but reads `src` only once
+TLCT_API void transposeConvert(const cv::Mat& src, cv::Mat& dst, cv::Mat& f32Dst);
+
 [[nodiscard]] TLCT_API uint16_t computeDhash(const cv::Mat& src);
 
 }  // namespace tlct::_cvt
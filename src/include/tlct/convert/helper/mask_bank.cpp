@@ -0,0 +1,43 @@
+#include <format>
+#include <new>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "tlct/convert/helper/functional.hpp"
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/mask_bank.hpp"
+#endif
+
+namespace tlct::_cvt {
+
+namespace rgs = std::ranges;
+
+CircleMaskBank::CircleMaskBank(std::vector<cv::Mat>&& masks, float fadeBegin, float fadeEnd) noexcept
+    : masks_(std::move(masks)), fadeBegin_(fadeBegin), fadeEnd_(fadeEnd) {}
+
+std::expected<CircleMaskBank, Error> CircleMaskBank::create(const int maxDiameter, const float fadeBegin,
+                                                            const float fadeEnd) noexcept {
+    if (maxDiameter < 0) [[unlikely]] {
+        auto errMsg = std::format("maxDiameter must be non-negative, got {}", maxDiameter);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    try {
+        std::vector<cv::Mat> masks;
+        masks.reserve(maxDiameter + 1);
+        for (const int diameter : rgs::views::iota(0, maxDiameter + 1)) {
+            masks.push_back(circleWithFadeoutBorder(diameter, fadeBegin, fadeEnd));
+        }
+        return CircleMaskBank{std::move(masks), fadeBegin, fadeEnd};
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+}
+
+}  // namespace tlct::_cvt
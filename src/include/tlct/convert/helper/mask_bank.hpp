@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_cvt {
+
+// Immutable set of `circleWithFadeoutBorder(diameter, fadeBegin, fadeEnd)` for every diameter in [0, maxDiameter].
+// Built once, then safe to share read-only across threads.
+class CircleMaskBank {
+    CircleMaskBank(std::vector<cv::Mat>&& masks, float fadeBegin, float fadeEnd) noexcept;
+
+public:
+    // Constructor
+    CircleMaskBank() noexcept = default;
+    CircleMaskBank(const CircleMaskBank& rhs) = delete;
+    CircleMaskBank& operator=(const CircleMaskBank& rhs) = delete;
+    CircleMaskBank(CircleMaskBank&& rhs) noexcept = default;
+    CircleMaskBank& operator=(CircleMaskBank&& rhs) noexcept = default;
+
+    // Initialize from
+    [[nodiscard]] TLCT_API static std::expected<CircleMaskBank, Error> create(int maxDiameter, float fadeBegin,
+                                                                              float fadeEnd) noexcept;
+
+    // Const methods
+    [[nodiscard]] int getMaxDiameter() const noexcept { return (int)masks_.size() - 1; }
+    [[nodiscard]] float getFadeBegin() const noexcept { return fadeBegin_; }
+    [[nodiscard]] float getFadeEnd() const noexcept { return fadeEnd_; }
+    // The returned mask must not be written to
+    [[nodiscard]] const cv::Mat& get(int diameter) const noexcept {
+        assert(diameter >= 0 && diameter <= getMaxDiameter());
+        return masks_[diameter];
+    }
+
+private:
+    std::vector<cv::Mat> masks_;
+    float fadeBegin_;
+    float fadeEnd_;
+};
+
+}  // namespace tlct::_cvt
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/mask_bank.cpp"
+#endif
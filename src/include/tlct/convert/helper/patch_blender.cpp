@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <ranges>
+
+#include <immintrin.h>
+#include <opencv2/core.hpp>
+
+#include "tlct/convert/helper/resample.hpp"
+#include "tlct/helper/constexpr/math.hpp"
+#include "tlct/helper/std.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/patch_blender.hpp"
+#endif
+
+namespace tlct::_cvt {
+
+namespace rgs = std::ranges;
+
+void PatchBlender::blend(const cv::Mat& src, const bool rotate180, const cv::Mat& mask, const float weight,
+                         cv::Mat& dst, cv::Mat& weightDst) {
+    if (mask.empty()) return;
+
+    // The horizontal pass runs on whole vectors, its tables and rows are padded
+    xTaps_.fill(src.cols, mask.cols, _hp::alignUp<LANES>(mask.cols), rotate180);
+    yTaps_.fill(src.rows, mask.rows, mask.rows, rotate180);
+    accumulate(src, false, mask, weight, dst, weightDst);
+}
+
+void PatchBlender::blend(const cv::Mat& plane, const bool transposed, const cv::Point2f center, const float width,
+                         const bool rotate180, const cv::Mat& mask, const float weight, cv::Mat& dst,
+                         cv::Mat& weightDst) {
+    if (mask.empty()) return;
+
+    const int imgCols = transposed ? plane.rows : plane.cols;
+    const int imgRows = transposed ? plane.cols : plane.rows;
+    const float halfWidth = width / 2.f;
+    xTaps_.fillWindow(center.x - halfWidth, width, imgCols, mask.cols, _hp::alignUp<LANES>(mask.cols), rotate180);
+    yTaps_.fillWindow(center.y - halfWidth, width, imgRows, mask.rows, mask.rows, rotate180);
+
+    if (transposed) {
+        // The horizontal taps walk down a column of `plane`
+        const int rowStep = (int)plane.step1();
+        rgs::transform(xTaps_.indices, xTaps_.indices.begin(), [rowStep](const int idx) { return idx * rowStep; });
+    }
+    accumulate(plane, transposed, mask, weight, dst, weightDst);
+}
+
+void PatchBlender::accumulate(const cv::Mat& src, const bool transposed, const cv::Mat& mask, const float weight,
+                              cv::Mat& dst, cv::Mat& weightDst) {
+    const int dstWidth = mask.cols;
+    const int dstHeight = mask.rows;
+    const int paddedWidth = _hp::alignUp<LANES>(dstWidth);
+
+    // Only the source rows reached by the vertical taps are resampled
+    const auto [minRowIt, maxRowIt] = rgs::minmax_element(yTaps_.indices);
+    const int rowBegin = *minRowIt;
+    const int rowCount = *maxRowIt - rowBegin + 1;
+    rowPass_.resize((size_t)rowCount * paddedWidth);
+
+    // Horizontal pass: every source row is resampled to the dst width
+    for (const int rowIdx : rgs::views::iota(0, rowCount)) {
+        const float* psrc = transposed ? src.ptr<float>(0) + rowBegin + rowIdx : src.ptr<float>(rowBegin + rowIdx);
+        float* prow = rowPass_.data() + (size_t)rowIdx * paddedWidth;
+        for (int col = 0; col < paddedWidth; col += LANES) {
+            __m256 acc = _mm256_setzero_ps();
+            for (const int tap : rgs::views::iota(0, TAPS)) {
+                const __m256i indices =
+                    _mm256_loadu_si256((const __m256i*)(xTaps_.indices.data() + tap * paddedWidth + col));
+                const __m256 coeffs = _mm256_loadu_ps(xTaps_.coeffs.data() + tap * paddedWidth + col);
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_i32gather_ps(psrc, indices, sizeof(float)), coeffs));
+            }
+            _mm256_storeu_ps(prow + col, acc);
+        }
+    }
+
+    // Vertical pass fused with the blending and the accumulation
+    const bool withWeight = !weightDst.empty();
+    const __m256 vweight = _mm256_set1_ps(weight);
+    for (const int row : rgs::views::iota(0, dstHeight)) {
+        const float* ptaps[TAPS];
+        float coeffs[TAPS];
+        for (const int tap : rgs::views::iota(0, TAPS)) {
+            ptaps[tap] = rowPass_.data() + (size_t)(yTaps_.indices[tap * dstHeight + row] - rowBegin) * paddedWidth;
+            coeffs[tap] = yTaps_.coeffs[tap * dstHeight + row];
+        }
+        const __m256 vcoeffs[TAPS]{_mm256_set1_ps(coeffs[0]), _mm256_set1_ps(coeffs[1]), _mm256_set1_ps(coeffs[2]),
+                                   _mm256_set1_ps(coeffs[3])};
+
+        const float* pmask = mask.ptr<float>(row);
+        float* pdst = dst.ptr<float>(row);
+        float* pweight = withWeight ? weightDst.ptr<float>(row) : nullptr;
+
+        int col = 0;
+        for (; col + LANES <= dstWidth; col += LANES) {
+            __m256 sample = _mm256_setzero_ps();
+            for (const int tap : rgs::views::iota(0, TAPS)) {
+                sample = _mm256_add_ps(sample, _mm256_mul_ps(_mm256_loadu_ps(ptaps[tap] + col), vcoeffs[tap]));
+            }
+            const __m256 blendWeight = _mm256_mul_ps(_mm256_loadu_ps(pmask + col), vweight);
+            _mm256_storeu_ps(pdst + col,
+                             _mm256_add_ps(_mm256_loadu_ps(pdst + col), _mm256_mul_ps(sample, blendWeight)));
+            if (withWeight) {
+                _mm256_storeu_ps(pweight + col, _mm256_add_ps(_mm256_loadu_ps(pweight + col), blendWeight));
+            }
+        }
+        for (; col < dstWidth; col++) {
+            float sample = 0.f;
+            for (const int tap : rgs::views::iota(0, TAPS)) {
+                sample += ptaps[tap][col] * coeffs[tap];
+            }
+            const float blendWeight = pmask[col] * weight;
+            pdst[col] += sample * blendWeight;
+            if (withWeight) pweight[col] += blendWeight;
+        }
+    }
+}
+
+}  // namespace tlct::_cvt
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "tlct/convert/helper/resample.hpp"
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_cvt {
+
+// Fused patch pasting kernel. Keep one per thread, the tables and the intermediate rows are reused across patches.
+class PatchBlender {
+public:
+    // Constructor
+    PatchBlender() noexcept = default;
+    PatchBlender(const PatchBlender& rhs) = delete;
+    PatchBlender& operator=(const PatchBlender& rhs) = delete;
+    PatchBlender(PatchBlender&& rhs) noexcept = default;
+    PatchBlender& operator=(PatchBlender&& rhs) noexcept = default;
+
+    // Non-const methods
+    // Equals `dst += weight * mask * resize(rotate180 ? rotate(src, ROTATE_180) : src, mask.size(), INTER_CUBIC)`
+    // and `weightDst += weight * mask` when `weightDst` is not empty, but runs as a single sweep over `dst`.
+    // All of `src`, `mask`, `dst` and `weightDst` are `CV_32FC1`, `dst` and `weightDst` have the size of `mask`.
+    TLCT_API void blend(const cv::Mat& src, bool rotate180, const cv::Mat& mask, float weight, cv::Mat& dst,
+                        cv::Mat& weightDst);
+    // Same as above, but `src` is the square window of `plane` centered at `center` with a fractional `width`.
+    // It is sampled at sub-pixel positions instead of being rounded to whole pixels.
+    // With `transposed`, `plane` holds the transpose of the sampled image and is addressed accordingly.
+    TLCT_API void blend(const cv::Mat& plane, bool transposed, cv::Point2f center, float width, bool rotate180,
+                        const cv::Mat& mask, float weight, cv::Mat& dst, cv::Mat& weightDst);
+
+private:
+    static constexpr int TAPS = CubicTaps::TAPS;
+    static constexpr int LANES = 8;  // floats per AVX2 register
+
+    // The horizontal taps index elements from the start of a row, or from the start of a column when `transposed`
+    void accumulate(const cv::Mat& src, bool transposed, const cv::Mat& mask, float weight, cv::Mat& dst,
+                    cv::Mat& weightDst);
+
+    CubicTaps xTaps_;
+    CubicTaps yTaps_;
+    std::vector<float> rowPass_;
+};
+
+}  // namespace tlct::_cvt
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/patch_blender.cpp"
+#endif
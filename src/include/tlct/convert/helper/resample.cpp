@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include <immintrin.h>
+#include <opencv2/core.hpp>
+
+#include "tlct/helper/constexpr/math.hpp"
+#include "tlct/helper/std.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/resample.hpp"
+#endif
+
+namespace tlct::_cvt {
+
+namespace rgs = std::ranges;
+
+// Writes the taps of dst pixel `dstIdx` sampling at `pos`, where pixel `i` is centered at `i`
+static inline void setCubicTaps(CubicTaps& taps, const int stride, const int dstIdx, const float pos, const int bound,
+                                const bool mirror) noexcept {
+    constexpr int TAPS = CubicTaps::TAPS;
+    constexpr float A = -0.75f;
+
+    const int srcIdx = (int)std::floor(pos);
+    const float fx = pos - (float)srcIdx;
+
+    const float c0 = ((A * (fx + 1) - 5 * A) * (fx + 1) + 8 * A) * (fx + 1) - 4 * A;
+    const float c1 = ((A + 2) * fx - (A + 3)) * fx * fx + 1;
+    const float c2 = ((A + 2) * (1 - fx) - (A + 3)) * (1 - fx) * (1 - fx) + 1;
+    const float tapCoeffs[TAPS]{c0, c1, c2, 1.f - c0 - c1 - c2};
+
+    for (const int tap : rgs::views::iota(0, TAPS)) {
+        const int clamped = std::clamp(srcIdx - 1 + tap, 0, bound - 1);
+        taps.indices[tap * stride + dstIdx] = mirror ? bound - 1 - clamped : clamped;
+        taps.coeffs[tap * stride + dstIdx] = tapCoeffs[tap];
+    }
+}
+
+void CubicTaps::fill(const int srcLen, const int dstLen, const int stride, const bool mirror) {
+    indices.assign(TAPS * stride, 0);
+    coeffs.assign(TAPS * stride, 0.f);
+
+    // Same sampling positions as `cv::resize`.
+    // Rotating the source by 180 degrees only mirrors the taps.
+    const double scale = 1.0 / ((double)dstLen / (double)srcLen);
+    for (const int dstIdx : rgs::views::iota(0, dstLen)) {
+        const float pos = (float)((dstIdx + 0.5) * scale - 0.5);
+        setCubicTaps(*this, stride, dstIdx, pos, srcLen, mirror);
+    }
+}
+
+void CubicTaps::fillWindow(const float begin, const float len, const int bound, const int dstLen, const int stride,
+                           const bool reversed) {
+    indices.assign(TAPS * stride, 0);
+    coeffs.assign(TAPS * stride, 0.f);
+
+    const double step = (double)len / (double)dstLen;
+    for (const int dstIdx : rgs::views::iota(0, dstLen)) {
+        const double offset = reversed ? len - (dstIdx + 0.5) * step : (dstIdx + 0.5) * step;
+        const float pos = (float)(begin + offset - 0.5);
+        setCubicTaps(*this, stride, dstIdx, pos, bound, false);
+    }
+}
+
+void CubicTaps::fillRange(const int srcLen, const int dstLen, const int dstBegin, const int dstCount,
+                          const int srcBegin, const int stride) {
+    indices.assign(TAPS * stride, 0);
+    coeffs.assign(TAPS * stride, 0.f);
+
+    const double scale = 1.0 / ((double)dstLen / (double)srcLen);
+    for (const int dstIdx : rgs::views::iota(0, dstCount)) {
+        const float pos = (float)((dstBegin + dstIdx + 0.5) * scale - 0.5);
+        setCubicTaps(*this, stride, dstIdx, pos, srcLen, false);
+        for (const int tap : rgs::views::iota(0, TAPS)) {
+            indices[tap * stride + dstIdx] -= srcBegin;
+        }
+    }
+}
+
+// Rounds to nearest like `cv::saturate_cast`, then stores 8 values clamped to [0, `vmax`].
+// `vmax` holds the max value in every lane of the dst type.
+template <typename T>
+static inline void storeSaturated(const __m256 values, const __m128i vmax, T* pdst) noexcept {
+    const __m256i i32 = _mm256_cvtps_epi32(values);
+    const __m128i lo = _mm256_castsi256_si128(i32);
+    const __m128i hi = _mm256_extracti128_si256(i32, 1);
+    if constexpr (std::is_same_v<T, uint8_t>) {
+        const __m128i i16 = _mm_packs_epi32(lo, hi);
+        _mm_storel_epi64((__m128i*)pdst, _mm_min_epu8(_mm_packus_epi16(i16, i16), vmax));
+    } else {
+        _mm_storeu_si128((__m128i*)pdst, _mm_min_epu16(_mm_packus_epi32(lo, hi), vmax));
+    }
+}
+
+// Same as `storeSaturated` for a single value
+template <typename T>
+static inline T saturateTo(const float value, const T maxValue) noexcept {
+    return std::min(cv::saturate_cast<T>(value), maxValue);
+}
+
+// `TSrc` is `float` for the normalized resize, where every source sample is multiplied by `scale`.
+// Integer sources are widened one row at a time and `scale` is unused.
+template <typename TSrc, typename T>
+static void resizeImpl(const cv::Mat& src, const cv::Mat& scale, const cv::Point srcOrigin, const cv::Size srcSize,
+                       cv::Mat& dst, const cv::Rect dstRoi, const cv::Size dstSize, const bool transposed,
+                       const int maxValue) {
+    constexpr bool NORMALIZED = std::is_same_v<TSrc, float>;
+    constexpr int TAPS = CubicTaps::TAPS;
+    constexpr int LANES = 8;
+
+    const T tMaxValue = (T)maxValue;
+    const __m128i vmax = std::is_same_v<T, uint8_t> ? _mm_set1_epi8((char)tMaxValue) : _mm_set1_epi16((short)tMaxValue);
+
+    // The first pass runs along the rows of `src`, the second one across them
+    const int rowPassLen = transposed ? dst.rows : dst.cols;
+    const int colPassLen = transposed ? dst.cols : dst.rows;
+    const int rowStride = _hp::alignUp<LANES>(rowPassLen);
+    const int colStride = _hp::alignUp<LANES>(colPassLen);
+
+    // Sampled on the full grids, then shifted onto the windows
+    CubicTaps rowTaps;
+    rowTaps.fillRange(srcSize.width, transposed ? dstSize.height : dstSize.width, transposed ? dstRoi.y : dstRoi.x,
+                      rowPassLen, srcOrigin.x, rowStride);
+    CubicTaps colTaps;
+    colTaps.fillRange(srcSize.height, transposed ? dstSize.width : dstSize.height, transposed ? dstRoi.x : dstRoi.y,
+                      colPassLen, srcOrigin.y, colStride);
+
+    // Normalize and resample every source row
+    std::vector<float> rowPass((size_t)src.rows * rowStride);
+    std::vector<float> widenedRow(NORMALIZED ? 0 : src.cols);
+    for (const int row : rgs::views::iota(0, src.rows)) {
+        const float* psrc;
+        const float* pscale = nullptr;
+        if constexpr (NORMALIZED) {
+            psrc = src.ptr<float>(row);
+            pscale = scale.ptr<float>(row);
+        } else {
+            std::copy_n(src.ptr<TSrc>(row), src.cols, widenedRow.begin());
+            psrc = widenedRow.data();
+        }
+
+        float* prow = rowPass.data() + (size_t)row * rowStride;
+        for (int col = 0; col < rowStride; col += LANES) {
+            __m256 acc = _mm256_setzero_ps();
+            for (const int tap : rgs::views::iota(0, TAPS)) {
+                const __m256i indices =
+                    _mm256_loadu_si256((const __m256i*)(rowTaps.indices.data() + tap * rowStride + col));
+                __m256 samples = _mm256_i32gather_ps(psrc, indices, sizeof(float));
+                if constexpr (NORMALIZED) {
+                    samples = _mm256_mul_ps(samples, _mm256_i32gather_ps(pscale, indices, sizeof(float)));
+                }
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(samples, _mm256_loadu_ps(rowTaps.coeffs.data() +
+                                                                                tap * rowStride + col)));
+            }
+            _mm256_storeu_ps(prow + col, acc);
+        }
+    }
+
+    if (!transposed) {
+        // Each dst row blends 4 whole rows of the first pass
+        for (const int row : rgs::views::iota(0, dst.rows)) {
+            const float* ptaps[TAPS];
+            __m256 vcoeffs[TAPS];
+            float coeffs[TAPS];
+            for (const int tap : rgs::views::iota(0, TAPS)) {
+                ptaps[tap] = rowPass.data() + (size_t)colTaps.indices[tap * colStride + row] * rowStride;
+                coeffs[tap] = colTaps.coeffs[tap * colStride + row];
+                vcoeffs[tap] = _mm256_set1_ps(coeffs[tap]);
+            }
+
+            T* pdst = dst.ptr<T>(row);
+            int col = 0;
+            for (; col + LANES <= dst.cols; col += LANES) {
+                __m256 acc = _mm256_setzero_ps();
+                for (const int tap : rgs::views::iota(0, TAPS)) {
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(ptaps[tap] + col), vcoeffs[tap]));
+                }
+                storeSaturated(acc, vmax, pdst + col);
+            }
+            for (; col < dst.cols; col++) {
+                float acc = 0.f;
+                for (const int tap : rgs::views::iota(0, TAPS)) {
+                    acc += ptaps[tap][col] * coeffs[tap];
+                }
+                pdst[col] = saturateTo(acc, tMaxValue);
+            }
+        }
+    } else {
+        // Dst row `i` is column `i` of the first pass, its pixels are gathered across the rows of the first pass
+        std::vector<int> offsets(colTaps.indices.size());
+        rgs::transform(colTaps.indices, offsets.begin(), [rowStride](const int idx) { return idx * rowStride; });
+
+        for (const int row : rgs::views::iota(0, dst.rows)) {
+            const float* pcol = rowPass.data() + row;
+            T* pdst = dst.ptr<T>(row);
+            int col = 0;
+            for (; col + LANES <= dst.cols; col += LANES) {
+                __m256 acc = _mm256_setzero_ps();
+                for (const int tap : rgs::views::iota(0, TAPS)) {
+                    const __m256i vOffsets =
+                        _mm256_loadu_si256((const __m256i*)(offsets.data() + tap * colStride + col));
+                    const __m256 vcoeffs = _mm256_loadu_ps(colTaps.coeffs.data() + tap * colStride + col);
+                    acc = _mm256_add_ps(acc,
+                                        _mm256_mul_ps(_mm256_i32gather_ps(pcol, vOffsets, sizeof(float)), vcoeffs));
+                }
+                storeSaturated(acc, vmax, pdst + col);
+            }
+            for (; col < dst.cols; col++) {
+                float acc = 0.f;
+                for (const int tap : rgs::views::iota(0, TAPS)) {
+                    acc += pcol[offsets[tap * colStride + col]] * colTaps.coeffs[tap * colStride + col];
+                }
+                pdst[col] = saturateTo(acc, tMaxValue);
+            }
+        }
+    }
+}
+
+void normalizeResize(const cv::Mat& src, const cv::Mat& scale, cv::Mat& dst, const cv::Size dstSize,
+                     const bool transposed, const int maxValue) {
+    normalizeResize(src, scale, {0, 0}, src.size(), dst, {{0, 0}, dstSize}, dstSize, transposed, maxValue);
+}
+
+cv::Rect getResizeSrcRoi(const cv::Size srcSize, const cv::Rect dstRoi, const cv::Size dstSize, const bool transposed) {
+    const auto getSrcRange = [](const int srcLen, const int dstLen, const int dstBegin, const int dstCount) {
+        CubicTaps taps;
+        taps.fillRange(srcLen, dstLen, dstBegin, dstCount, 0, dstCount);
+        const auto [minIt, maxIt] = rgs::minmax_element(taps.indices);
+        return cv::Range{*minIt, *maxIt + 1};
+    };
+
+    // The first pass samples the source columns, which become the dst rows when transposed
+    const cv::Range colRange = transposed ? getSrcRange(srcSize.width, dstSize.height, dstRoi.y, dstRoi.height)
+                                          : getSrcRange(srcSize.width, dstSize.width, dstRoi.x, dstRoi.width);
+    const cv::Range rowRange = transposed ? getSrcRange(srcSize.height, dstSize.width, dstRoi.x, dstRoi.width)
+                                          : getSrcRange(srcSize.height, dstSize.height, dstRoi.y, dstRoi.height);
+
+    return {colRange.start, rowRange.start, colRange.size(), rowRange.size()};
+}
+
+void normalizeResize(const cv::Mat& src, const cv::Mat& scale, const cv::Point srcOrigin, const cv::Size srcSize,
+                     cv::Mat& dst, const cv::Rect dstRoi, const cv::Size dstSize, const bool transposed,
+                     const int maxValue) {
+    dst.create(dstRoi.size(), dst.type());
+    if (dst.depth() == CV_8U) {
+        resizeImpl<float, uint8_t>(src, scale, srcOrigin, srcSize, dst, dstRoi, dstSize, transposed, maxValue);
+    } else {
+        resizeImpl<float, uint16_t>(src, scale, srcOrigin, srcSize, dst, dstRoi, dstSize, transposed, maxValue);
+    }
+}
+
+void transposeResize(const cv::Mat& src, cv::Mat& dst, const cv::Size dstSize) {
+    if (dstSize.width == src.rows && dstSize.height == src.cols) {
+        cv::transpose(src, dst);
+        return;
+    }
+
+    dst.create(dstSize, src.type());
+    const cv::Rect dstRoi{{0, 0}, dstSize};
+    if (src.depth() == CV_8U) {
+        resizeImpl<uint8_t, uint8_t>(src, {}, {0, 0}, src.size(), dst, dstRoi, dstSize, true,
+                                     std::numeric_limits<uint8_t>::max());
+    } else {
+        resizeImpl<uint16_t, uint16_t>(src, {}, {0, 0}, src.size(), dst, dstRoi, dstSize, true,
+                                       std::numeric_limits<uint16_t>::max());
+    }
+}
+
+}  // namespace tlct::_cvt
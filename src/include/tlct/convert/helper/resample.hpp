@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_cvt {
+
+// Taps of `cv::resize(..., INTER_CUBIC)` along one axis
+struct CubicTaps {
+    static constexpr int TAPS = 4;
+
+    // Tap `i` of dst pixel `j` lives at `i * stride + j`.
+    // Padding lanes read the first source pixel with a zero coefficient.
+    // Out-of-range taps are clamped, and mirrored when the source is flipped.
+    TLCT_API void fill(int srcLen, int dstLen, int stride, bool mirror);
+    // Samples the window [begin, begin + len) of a source with `bound` pixels, where pixel `i` covers [i, i + 1).
+    // `reversed` walks the window backwards, which is the sub-pixel counterpart of `mirror`.
+    TLCT_API void fillWindow(float begin, float len, int bound, int dstLen, int stride, bool reversed);
+    // Same taps as `fill` without `mirror`, but only for the dst pixels [dstBegin, dstBegin + dstCount).
+    // The indices are relative to the source pixel `srcBegin`.
+    TLCT_API void fillRange(int srcLen, int dstLen, int dstBegin, int dstCount, int srcBegin, int stride);
+
+    std::vector<int> indices;
+    std::vector<float> coeffs;
+};
+
+// Equals `resize(transpose(src), dst, dstSize)` with cubic interpolation up to the rounding of the last bit,
+// since the two axes are resampled in the other order. No transposed copy of `src` is made.
+// `src` is a `CV_8UC1` or `CV_16UC1` plane, `dst` gets the same type.
+TLCT_API void transposeResize(const cv::Mat& src, cv::Mat& dst, cv::Size dstSize);
+
+// Equals `resize(src.mul(scale), dst, dstSize)` with cubic interpolation, or `transposeResize` when `transposed`,
+// then a saturating cast to the depth of `dst`. Runs without any intermediate image of the dst depth.
+// `src` and `scale` are `CV_32FC1` of the same size, `dst` is a preallocated `CV_8UC1` or `CV_16UC1` plane.
+// The samples are clamped to `maxValue`, i.e. `(1 << bitDepth) - 1` of the output, since the cubic taps overshoot.
+TLCT_API void normalizeResize(const cv::Mat& src, const cv::Mat& scale, cv::Mat& dst, cv::Size dstSize,
+                              bool transposed, int maxValue);
+// The source pixels reached by the taps of the window `dstRoi`, when `normalizeResize` maps `srcSize` to `dstSize`
+TLCT_API cv::Rect getResizeSrcRoi(cv::Size srcSize, cv::Rect dstRoi, cv::Size dstSize, bool transposed);
+// Only renders the window `dstRoi` of the `normalizeResize` output into `dst`, which has the size of `dstRoi`.
+// `src` and `scale` are the window of a `srcSize` source starting at `srcOrigin`, which covers `getResizeSrcRoi`.
+TLCT_API void normalizeResize(const cv::Mat& src, const cv::Mat& scale, cv::Point srcOrigin, cv::Size srcSize,
+                              cv::Mat& dst, cv::Rect dstRoi, cv::Size dstSize, bool transposed, int maxValue);
+
+}  // namespace tlct::_cvt
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/convert/helper/resample.cpp"
+#endif
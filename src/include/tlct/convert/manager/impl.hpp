@@ -3,8 +3,12 @@
 #include <filesystem>
 #include <format>
 #include <memory>
+#include <new>
+#include <span>
+#include <vector>
 
 #include "tlct/config/common.hpp"
+#include "tlct/convert/common/bridge.hpp"
 #include "tlct/convert/common/cache.hpp"
 #include "tlct/convert/concepts/manager.hpp"
 #include "tlct/convert/manager/traits.hpp"
@@ -27,8 +31,11 @@ public:
     using TCvtConfig = cfg::CliConfig::Convert;
     using TPsizeImpl = TTraits::TPsizeImpl;
     using TMvImpl = TTraits::TMvImpl;
+    using TMvCache = TMvImpl::TMvCache;
     using TCommonCache = CommonCache_<TArrange>;
     using TBridge = TPsizeImpl::TBridge;
+    using TBridgeWriter = BridgeFileWriter_<TBridge>;
+    using TBridgeReader = BridgeFileReader_<TBridge>;
 
 private:
     Manager_(std::shared_ptr<TArrange>&& pArrange, const TCvtConfig& cvtCfg,
@@ -51,6 +58,12 @@ public:
     [[nodiscard]] cv::Size getOutputSize() const noexcept { return mvImpl_.getOutputSize(); }
     [[nodiscard]] std::expected<void, Error> renderInto(io::YuvPlanarFrame& dst, int viewRow,
                                                         int viewCol) const noexcept;
+    // Renders only the window `roi` of the view, `dst` has the size of `roi`
+    [[nodiscard]] std::expected<void, Error> renderInto(io::YuvPlanarFrame& dst, int viewRow, int viewCol,
+                                                        cv::Rect roi) const noexcept;
+    // Renders the view `viewIndices[i]` ({viewCol, viewRow}) into `dsts[i]` in one batch
+    [[nodiscard]] std::expected<void, Error> renderViews(std::span<io::YuvPlanarFrame> dsts,
+                                                         std::span<const cv::Point> viewIndices) const noexcept;
 
     // Non-const methods
     [[nodiscard]] std::expected<void, Error> update(const io::YuvPlanarFrame& src) noexcept;
@@ -59,8 +72,11 @@ public:
     [[nodiscard]] std::expected<void, Error> updateCommonCache(const io::YuvPlanarFrame& src) noexcept;
     [[nodiscard]] TBridge& getBridge() noexcept { return bridge_; }
     [[nodiscard]] TArrange& getArrange() noexcept { return *pArrange_; }
-    [[nodiscard]] std::expected<void, Error> dumpBridge(const fs::path& dumpTo) const noexcept;
-    [[nodiscard]] std::expected<void, Error> loadBridge(const fs::path& loadFrom) noexcept;
+    [[nodiscard]] std::expected<TBridgeWriter, Error> createBridgeWriter(const fs::path& dumpTo,
+                                                                         int keyframeInterval) const noexcept;
+    [[nodiscard]] std::expected<TBridgeReader, Error> createBridgeReader(const fs::path& loadFrom) const noexcept;
+    [[nodiscard]] std::expected<void, Error> dumpBridge(TBridgeWriter& writer, int fid) const noexcept;
+    [[nodiscard]] std::expected<void, Error> loadBridge(TBridgeReader& reader, int fid) noexcept;
 
 private:
     std::shared_ptr<TArrange> pArrange_;
@@ -69,6 +85,8 @@ private:
     TPsizeImpl psizeImpl_;
     TBridge bridge_;
     TMvImpl mvImpl_;
+    // One scratch cache per view of a `renderViews` batch. Only grows, so the buffers are reused across frames.
+    mutable std::vector<TMvCache> mvCachePool_;
 };
 
 template <concepts::CManagerTraits TTraits>
@@ -87,7 +105,7 @@ auto Manager_<TTraits>::create(const TArrange& arrange, const TCvtConfig& cvtCfg
     -> std::expected<Manager_, Error> {
     auto pArrange = std::make_shared<TArrange>(arrange);
 
-    auto commonCacheRes = TCommonCache::create(arrange);
+    auto commonCacheRes = TCommonCache::create(arrange, cvtCfg.directRender);
     if (!commonCacheRes) return std::unexpected{std::move(commonCacheRes.error())};
     auto pCommonCache = std::make_shared<TCommonCache>(std::move(commonCacheRes.value()));
 
@@ -122,6 +140,9 @@ std::expected<void, Error> Manager_<TTraits>::update(const io::YuvPlanarFrame& s
     auto psizeUpdateRes = psizeImpl_.updateBridge(pCommonCache_->srcs[0], bridge_);
     if (!psizeUpdateRes) return std::unexpected{std::move(psizeUpdateRes.error())};
 
+    auto weightsUpdateRes = mvImpl_.updateWeights(bridge_);
+    if (!weightsUpdateRes) return std::unexpected{std::move(weightsUpdateRes.error())};
+
     return {};
 }
 
@@ -134,28 +155,55 @@ std::expected<void, Error> Manager_<TTraits>::renderInto(io::YuvPlanarFrame& dst
 }
 
 template <concepts::CManagerTraits TTraits>
-std::expected<void, Error> Manager_<TTraits>::dumpBridge(const fs::path& dumpTo) const noexcept {
-    std::ofstream ofs{dumpTo, std::ios::binary};
-    if (!ofs.good()) [[unlikely]] {
-        auto errMsg = std::format("failed to open file. path={}", dumpTo.string());
-        return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
-    }
-
-    const auto& patchInfos = bridge_.getInfos();
-    ofs.write((char*)patchInfos.data(), patchInfos.size() * sizeof(patchInfos[0]));
+std::expected<void, Error> Manager_<TTraits>::renderInto(io::YuvPlanarFrame& dst, int viewRow, int viewCol,
+                                                         cv::Rect roi) const noexcept {
+    auto renderRes = mvImpl_.renderViewRoi(bridge_, dst, viewRow, viewCol, roi);
+    if (!renderRes) return std::unexpected{std::move(renderRes.error())};
     return {};
 }
 
 template <concepts::CManagerTraits TTraits>
-std::expected<void, Error> Manager_<TTraits>::loadBridge(const fs::path& loadFrom) noexcept {
-    std::ifstream ifs{loadFrom, std::ios::binary};
-    if (!ifs.good()) [[unlikely]] {
-        auto errMsg = std::format("failed to open file. path={}", loadFrom.string());
-        return std::unexpected{Error{ECate::eSys, ifs.rdstate(), std::move(errMsg)}};
+std::expected<void, Error> Manager_<TTraits>::renderViews(std::span<io::YuvPlanarFrame> dsts,
+                                                          std::span<const cv::Point> viewIndices) const noexcept {
+    try {
+        while (mvCachePool_.size() < viewIndices.size()) {
+            auto cacheRes = mvImpl_.createCache();
+            if (!cacheRes) return std::unexpected{std::move(cacheRes.error())};
+            mvCachePool_.push_back(std::move(cacheRes.value()));
+        }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
     }
 
-    auto& patchInfos = bridge_.getInfos();
-    ifs.read((char*)patchInfos.data(), patchInfos.size() * sizeof(patchInfos[0]));
+    const std::span<TMvCache> caches = std::span{mvCachePool_}.first(viewIndices.size());
+    return mvImpl_.renderViews(bridge_, dsts, viewIndices, caches);
+}
+
+template <concepts::CManagerTraits TTraits>
+auto Manager_<TTraits>::createBridgeWriter(const fs::path& dumpTo, int keyframeInterval) const noexcept
+    -> std::expected<TBridgeWriter, Error> {
+    return TBridgeWriter::create(dumpTo, *pArrange_, cvtCfg_, keyframeInterval);
+}
+
+template <concepts::CManagerTraits TTraits>
+auto Manager_<TTraits>::createBridgeReader(const fs::path& loadFrom) const noexcept
+    -> std::expected<TBridgeReader, Error> {
+    return TBridgeReader::create(loadFrom, *pArrange_);
+}
+
+template <concepts::CManagerTraits TTraits>
+std::expected<void, Error> Manager_<TTraits>::dumpBridge(TBridgeWriter& writer, int fid) const noexcept {
+    return writer.write(fid, bridge_);
+}
+
+template <concepts::CManagerTraits TTraits>
+std::expected<void, Error> Manager_<TTraits>::loadBridge(TBridgeReader& reader, int fid) noexcept {
+    auto readRes = reader.readInto(fid, bridge_);
+    if (!readRes) return std::unexpected{std::move(readRes.error())};
+
+    auto weightsUpdateRes = mvImpl_.updateWeights(bridge_);
+    if (!weightsUpdateRes) return std::unexpected{std::move(weightsUpdateRes.error())};
+
     return {};
 }
 
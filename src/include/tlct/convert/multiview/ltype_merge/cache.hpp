@@ -38,9 +38,6 @@ public:
     cv::Mat weightCanvas;
     cv::Mat gradsWeightCanvas;
     std::array<cv::Mat, CHANNELS> lenTypeWeights;
-
-    cv::Mat f32Chan;
-    cv::Mat u8NormedImage;
 };
 
 }  // namespace tlct::_cvt::lm
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <format>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
@@ -28,13 +32,13 @@ public:
     using TCvtConfig = cfg::CliConfig::Convert;
     using TArrange = TArrange_;
     using TCommonCache = CommonCache_<TArrange>;
+    using TMvCache = MvCache_<TArrange>;
 
 private:
     using TMvParams = MvParams_<TArrange>;
-    using TMvCache = MvCache_<TArrange>;
 
-    MvImpl_(const TArrange& arrange, const TMvParams& params, TMvCache&& cache,
-            std::shared_ptr<TCommonCache>&& pCommonCache) noexcept;
+    MvImpl_(const TArrange& arrange, const TMvParams& params, TMvCache&& cache, CircleMaskBank&& blendMasks,
+            CircleMaskBank&& gradsMasks, std::shared_ptr<TCommonCache>&& pCommonCache) noexcept;
 
 public:
     // Constructor
@@ -53,31 +57,54 @@ public:
         return {params_.outputWidth, params_.outputHeight};
     }
 
+    // Scratch buffers for rendering, one per view in flight
+    [[nodiscard]] TLCT_API std::expected<TMvCache, Error> createCache() const noexcept;
+
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
+                                                        int viewCol) const noexcept {
+        return renderView(bridge, dst, viewRow, viewCol, mvCache_);
+    }
     template <concepts::CPatchMergeBridge TBridge>
     [[nodiscard]] std::expected<void, Error> renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
-                                                        int viewCol) const noexcept;
+                                                        int viewCol, TMvCache& cache) const noexcept;
+    // Renders the view `viewIndices[i]` ({viewCol, viewRow}) into `dsts[i]` using `caches[i]`
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderViews(const TBridge& bridge, std::span<io::YuvPlanarFrame> dsts,
+                                                         std::span<const cv::Point> viewIndices,
+                                                         std::span<TMvCache> caches) const noexcept;
+
+    // Non-const methods
+    // The len type weights depend on the view, so there is nothing to precompute per frame
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> updateWeights([[maybe_unused]] const TBridge& bridge) noexcept {
+        return {};
+    }
 
 private:
     template <concepts::CPatchMergeBridge TBridge>
     [[nodiscard]] std::expected<void, Error> genLenTypeWeight(const TBridge& bridge, const cv::Mat& src,
                                                               std::array<cv::Mat, 3>& lenTypeWeights, int viewRow,
-                                                              int viewCol) const noexcept;
+                                                              int viewCol, TMvCache& cache) const noexcept;
     template <concepts::CPatchMergeBridge TBridge>
     [[nodiscard]] std::expected<void, Error> renderChan(const TBridge& bridge,
                                                         const std::array<cv::Mat, 3>& lenTypeWeights,
-                                                        const cv::Mat& src, cv::Mat& dst, cv::Size dstSize, int viewRow,
-                                                        int viewCol) const noexcept;
+                                                        const cv::Mat& src, int shift, cv::Mat& dst, cv::Size dstSize,
+                                                        int maxValue, int viewRow, int viewCol,
+                                                        TMvCache& cache) const noexcept;
 
     TArrange arrange_;
     TMvParams params_;
     std::shared_ptr<TCommonCache> pCommonCache_;
     mutable TMvCache mvCache_;
+    CircleMaskBank blendMasks_;
+    CircleMaskBank gradsMasks_;
 };
 
 template <cfg::concepts::CArrange TArrange>
 template <concepts::CPatchMergeBridge TBridge>
 std::expected<void, Error> MvImpl_<TArrange>::renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
-                                                         int viewCol) const noexcept {
+                                                         int viewCol, TMvCache& cache) const noexcept {
     // TODO: handle `std::bad_alloc` in this func
     std::array<std::reference_wrapper<cv::Mat>, TCommonCache::CHANNELS> channels{
         std::ref(dst.getY()), std::ref(dst.getU()), std::ref(dst.getV())};
@@ -87,22 +114,18 @@ std::expected<void, Error> MvImpl_<TArrange>::renderView(const TBridge& bridge,
         frameExtent.getUSize(),
         frameExtent.getVSize(),
     };
-
-    if (arrange_.getDirection()) {
-        for (auto& channelSize : channelSizes) {
-            std::swap(channelSize.width, channelSize.height);
-        }
-    }
+    const int maxValue = (1 << frameExtent.getBitDepth()) - 1;
 
     // gen len type weight
-    auto genWeightRes = genLenTypeWeight(bridge, pCommonCache_->srcs[0], mvCache_.lenTypeWeights, viewRow, viewCol);
+    auto genWeightRes =
+        genLenTypeWeight(bridge, pCommonCache_->f32Srcs[0], cache.lenTypeWeights, viewRow, viewCol, cache);
     if (!genWeightRes) return std::unexpected{std::move(genWeightRes.error())};
 
     if constexpr (TLCT_ENABLE_DEBUG) {
         std::array<cv::Mat, 3> lenTypeWeightsU8;
 
         for (int i = 0; i < 3; i++) {
-            mvCache_.lenTypeWeights[i].convertTo(lenTypeWeightsU8[i], CV_8UC1, 255.0);
+            cache.lenTypeWeights[i].convertTo(lenTypeWeightsU8[i], CV_8UC1, 255.0);
         }
 
         cv::Mat rgbImage;
@@ -113,15 +136,38 @@ std::expected<void, Error> MvImpl_<TArrange>::renderView(const TBridge& bridge,
 
     // render channels
     for (const int chanIdx : rgs::views::iota(0, TCommonCache::CHANNELS)) {
-        auto renderChanRes = renderChan(bridge, mvCache_.lenTypeWeights, pCommonCache_->srcs[chanIdx],
-                                        channels[chanIdx], channelSizes[chanIdx], viewRow, viewCol);
+        auto renderChanRes =
+            renderChan(bridge, cache.lenTypeWeights, pCommonCache_->f32Srcs[chanIdx], pCommonCache_->shifts[chanIdx],
+                       channels[chanIdx], channelSizes[chanIdx], maxValue, viewRow, viewCol, cache);
         if (!renderChanRes) return std::unexpected{std::move(renderChanRes.error())};
     }
 
-    if (arrange_.getDirection()) {
-        cv::transpose(dst.getY(), dst.getY());
-        cv::transpose(dst.getU(), dst.getU());
-        cv::transpose(dst.getV(), dst.getV());
+    return {};
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+std::expected<void, Error> MvImpl_<TArrange>::renderViews(const TBridge& bridge, std::span<io::YuvPlanarFrame> dsts,
+                                                          std::span<const cv::Point> viewIndices,
+                                                          std::span<TMvCache> caches) const noexcept {
+    if (dsts.size() != viewIndices.size() || caches.size() < viewIndices.size()) [[unlikely]] {
+        auto errMsg = std::format("expect a dst frame and a cache per view, got {} frames, {} caches for {} views",
+                                  dsts.size(), caches.size(), viewIndices.size());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    // The len type weights are per view, so views are simply rendered side by side
+    const int viewCount = (int)viewIndices.size();
+    std::vector<std::expected<void, Error>> renderResults(viewCount);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int viewIdx = 0; viewIdx < viewCount; viewIdx++) {
+        const cv::Point viewIndex = viewIndices[viewIdx];
+        renderResults[viewIdx] = renderView(bridge, dsts[viewIdx], viewIndex.y, viewIndex.x, caches[viewIdx]);
+    }
+
+    for (auto& renderRes : renderResults) {
+        if (!renderRes) return std::unexpected{std::move(renderRes.error())};
     }
 
     return {};
@@ -131,20 +177,19 @@ template <cfg::concepts::CArrange TArrange>
 template <concepts::CPatchMergeBridge TBridge>
 std::expected<void, Error> MvImpl_<TArrange>::genLenTypeWeight(const TBridge& bridge, const cv::Mat& src,
                                                                std::array<cv::Mat, 3>& lenTypeWeights, int viewRow,
-                                                               int viewCol) const noexcept {
+                                                               int viewCol, TMvCache& cache) const noexcept {
     const float viewShiftX = (viewCol - params_.views / 2) * params_.viewInterval;
     const float viewShiftY = (viewRow - params_.views / 2) * params_.viewInterval;
+    // Same mapping as `renderChan` on the luma plane
+    const float scale = params_.renderScale;
+    const float centerBias = 0.5f * scale - 0.5f;
 
-    src.convertTo(mvCache_.f32Chan, CV_32FC1);
-
-    cv::Mat resizedPatch;
-    cv::Mat rotatedPatch;
-    cv::Mat blendedPatch;
+    PatchBlender blender;
 
     const cfg::MITypes miTypes{arrange_.isOutShift()};
     for (int lenType = 0; lenType < 3; lenType++) {
-        mvCache_.renderCanvas.setTo(0);
-        mvCache_.weightCanvas.setTo(0);
+        cache.renderCanvas.setTo(0);
+        cache.weightCanvas.setTo(0);
 
         for (const int row : rgs::views::iota(0, arrange_.getMIRows())) {
             for (const int col : rgs::views::iota(0, arrange_.getMICols(row))) {
@@ -155,26 +200,17 @@ std::expected<void, Error> MvImpl_<TArrange>::genLenTypeWeight(const TBridge& br
 
                 // Extract patch
                 const cv::Point2f center = arrange_.getMICenter(row, col);
-                const float psize = bridge.getPatchsize(row, col);
+                const float psize = bridge.getPatchsize(row, col) * scale;
                 const float patchWidth = std::min(psize * params_.psizeInflate, params_.maxPsize);
                 const float psizeInflate = patchWidth / psize;
-                const int resizedPatchWidth = _hp::iround(psizeInflate * params_.patchXShift);
-                const cv::Point2f patchCenter{center.x + viewShiftX, center.y + viewShiftY};
-                const cv::Mat& patch = getRoiImageByCenter(mvCache_.f32Chan, patchCenter, patchWidth);
-
-                // Paste patch
-                if (arrange_.isKepler()) {
-                    cv::resize(patch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0, cv::INTER_CUBIC);
-                } else {
-                    cv::rotate(patch, rotatedPatch, cv::ROTATE_180);
-                    cv::resize(rotatedPatch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0,
-                               cv::INTER_CUBIC);
-                }
-
-                cv::Mat gradBlendingWeight = circleWithFadeoutBorder(resizedPatchWidth, 0.0f, 1.0f);
-                cv::multiply(resizedPatch, gradBlendingWeight, blendedPatch);
+                // Patch sizes may come from a loaded bridge container
+                const int resizedPatchWidth =
+                    std::clamp(_hp::iround(psizeInflate * params_.patchXShift), 0, blendMasks_.getMaxDiameter());
+                const cv::Point2f patchCenter{center.x * scale + centerBias + viewShiftX,
+                                              center.y * scale + centerBias + viewShiftY};
 
-                cv::Mat gradBlendingWeight4Grads = circleWithFadeoutBorder(resizedPatchWidth, 0.7f, 0.8f);
+                const cv::Mat& gradBlendingWeight = blendMasks_.get(resizedPatchWidth);
+                const cv::Mat& gradBlendingWeight4Grads = gradsMasks_.get(resizedPatchWidth);
 
                 // if the second bar is not out shift, then we need to shift the 1 col
                 // else if the second bar is out shift, then we need to shift the 0 col
@@ -182,16 +218,24 @@ std::expected<void, Error> MvImpl_<TArrange>::genLenTypeWeight(const TBridge& br
                 const cv::Rect roi{_hp::iround(col * params_.patchXShift + rightShift),
                                    _hp::iround(row * params_.patchYShift), resizedPatchWidth, resizedPatchWidth};
 
-                mvCache_.renderCanvas(roi) += blendedPatch;
-                mvCache_.weightCanvas(roi) += gradBlendingWeight;
-                mvCache_.gradsWeightCanvas(roi) += gradBlendingWeight4Grads;
+                // Paste patch, Galilean MIs are rotated by 180 degrees
+                cv::Mat renderRoi = cache.renderCanvas(roi);
+                cv::Mat weightRoi = cache.weightCanvas(roi);
+                if (params_.directRender) {
+                    blender.blend(src, arrange_.getDirection(), patchCenter, patchWidth, !arrange_.isKepler(),
+                                  gradBlendingWeight, 1.f, renderRoi, weightRoi);
+                } else {
+                    const cv::Mat& patch = getRoiImageByCenter(src, patchCenter, patchWidth);
+                    blender.blend(patch, !arrange_.isKepler(), gradBlendingWeight, 1.f, renderRoi, weightRoi);
+                }
+                cache.gradsWeightCanvas(roi) += gradBlendingWeight4Grads;
             }
         }
 
-        cv::divide(mvCache_.renderCanvas, mvCache_.weightCanvas, mvCache_.renderCanvas);
-        cv::Mat mvImage = mvCache_.renderCanvas(params_.canvasCropRoi);
+        cv::divide(cache.renderCanvas, cache.weightCanvas, cache.renderCanvas);
+        cv::Mat mvImage = cache.renderCanvas(params_.canvasCropRoi);
 
-        cv::Mat gradsWeight = mvCache_.gradsWeightCanvas(params_.canvasCropRoi);
+        cv::Mat gradsWeight = cache.gradsWeightCanvas(params_.canvasCropRoi);
         cv::min(gradsWeight, 1.0, gradsWeight);
 
         cv::Mat gradsMap;
@@ -236,28 +280,44 @@ template <cfg::concepts::CArrange TArrange>
 template <concepts::CPatchMergeBridge TBridge>
 std::expected<void, Error> MvImpl_<TArrange>::renderChan(const TBridge& bridge,
                                                          const std::array<cv::Mat, 3>& lenTypeWeights,
-                                                         const cv::Mat& src, cv::Mat& dst, cv::Size dstSize,
-                                                         int viewRow, int viewCol) const noexcept {
-    const float viewShiftX = (viewCol - params_.views / 2) * params_.viewInterval;
-    const float viewShiftY = (viewRow - params_.views / 2) * params_.viewInterval;
-
-    cv::Mat renderCanvas(cv::Size{params_.canvasCropRoi[1].size(), params_.canvasCropRoi[0].size()},
-                         mvCache_.renderCanvas.type());
-    cv::Mat weightCanvas(cv::Size{params_.canvasCropRoi[1].size(), params_.canvasCropRoi[0].size()},
-                         mvCache_.weightCanvas.type());
+                                                         const cv::Mat& src, const int shift, cv::Mat& dst,
+                                                         cv::Size dstSize, int maxValue, int viewRow, int viewCol,
+                                                         TMvCache& cache) const noexcept {
+    // Subsampled planes are rendered on their own grid with the MI geometry scaled down
+    const TMvParams params = params_.scaled(shift);
+    const float scale = params.renderScale;
+    // Maps pixel centers of the arrange grid onto the grid of this plane, zero when both grids match
+    const float centerBias = 0.5f * scale - 0.5f;
+
+    const float viewShiftX = (viewCol - params.views / 2) * params.viewInterval;
+    const float viewShiftY = (viewRow - params.views / 2) * params.viewInterval;
+
+    cv::Mat renderCanvas(params.getRoiSize(), cache.renderCanvas.type());
+    cv::Mat weightCanvas(params.getRoiSize(), cache.weightCanvas.type());
     renderCanvas.setTo(std::numeric_limits<float>::epsilon());
     weightCanvas.setTo(std::numeric_limits<float>::epsilon());
 
-    src.convertTo(mvCache_.f32Chan, CV_32FC1);
+    // The len type weights live on the luma grid
+    std::array<cv::Mat, 3> scaledLenTypeWeights;
+    if (shift != 0) {
+        for (const int lenType : rgs::views::iota(0, 3)) {
+            cv::resize(lenTypeWeights[lenType], scaledLenTypeWeights[lenType], params.getRoiSize(), 0, 0,
+                       cv::INTER_AREA);
+        }
+    } else {
+        scaledLenTypeWeights = lenTypeWeights;
+    }
 
-    cv::Mat resizedPatch;
-    cv::Mat rotatedPatch;
-    cv::Mat blendedPatch;
+    const cv::Rect canvasRoi{0, 0, params.canvasWidth, params.canvasHeight};
+    cv::Mat lenTypeRenderCanvas = cache.renderCanvas(canvasRoi);
+    cv::Mat lenTypeWeightCanvas = cache.weightCanvas(canvasRoi);
+
+    PatchBlender blender;
 
     const cfg::MITypes miTypes{arrange_.isOutShift()};
     for (int lenType = 0; lenType < 3; lenType++) {
-        mvCache_.renderCanvas.setTo(0);
-        mvCache_.weightCanvas.setTo(0);
+        lenTypeRenderCanvas.setTo(0);
+        lenTypeWeightCanvas.setTo(0);
 
         for (const int row : rgs::views::iota(0, arrange_.getMIRows())) {
             for (const int col : rgs::views::iota(0, arrange_.getMICols(row))) {
@@ -268,47 +328,48 @@ std::expected<void, Error> MvImpl_<TArrange>::renderChan(const TBridge& bridge,
 
                 // Extract patch
                 const cv::Point2f center = arrange_.getMICenter(row, col);
-                const float psize = bridge.getPatchsize(row, col);
-                const float patchWidth = std::min(psize * params_.psizeInflate, params_.maxPsize);
+                const float psize = bridge.getPatchsize(row, col) * scale;
+                const float patchWidth = std::min(psize * params.psizeInflate, params.maxPsize);
                 const float psizeInflate = patchWidth / psize;
-                const int resizedPatchWidth = _hp::iround(psizeInflate * params_.patchXShift);
-                const cv::Point2f patchCenter{center.x + viewShiftX, center.y + viewShiftY};
-                const cv::Mat& patch = getRoiImageByCenter(mvCache_.f32Chan, patchCenter, patchWidth);
-
-                // Paste patch
-                if (arrange_.isKepler()) {
-                    cv::resize(patch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0, cv::INTER_CUBIC);
-                } else {
-                    cv::rotate(patch, rotatedPatch, cv::ROTATE_180);
-                    cv::resize(rotatedPatch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0,
-                               cv::INTER_CUBIC);
-                }
+                // Patch sizes may come from a loaded bridge container
+                const int resizedPatchWidth =
+                    std::clamp(_hp::iround(psizeInflate * params.patchXShift), 0, blendMasks_.getMaxDiameter());
+                const cv::Point2f patchCenter{center.x * scale + centerBias + viewShiftX,
+                                              center.y * scale + centerBias + viewShiftY};
 
-                cv::Mat gradBlendingWeight = circleWithFadeoutBorder(resizedPatchWidth, 0.0f, 1.0f);
-                cv::multiply(resizedPatch, gradBlendingWeight, blendedPatch);
+                const cv::Mat& gradBlendingWeight = blendMasks_.get(resizedPatchWidth);
 
                 // if the second bar is not out shift, then we need to shift the 1 col
                 // else if the second bar is out shift, then we need to shift the 0 col
-                const float rightShift = ((row % 2) ^ (int)arrange_.isOutShift()) * (params_.patchXShift / 2);
-                const cv::Rect roi{_hp::iround(col * params_.patchXShift + rightShift),
-                                   _hp::iround(row * params_.patchYShift), resizedPatchWidth, resizedPatchWidth};
-
-                mvCache_.renderCanvas(roi) += blendedPatch;
-                mvCache_.weightCanvas(roi) += gradBlendingWeight;
+                const float rightShift = ((row % 2) ^ (int)arrange_.isOutShift()) * (params.patchXShift / 2);
+                const cv::Rect roi{_hp::iround(col * params.patchXShift + rightShift),
+                                   _hp::iround(row * params.patchYShift), resizedPatchWidth, resizedPatchWidth};
+
+                // Paste patch, Galilean MIs are rotated by 180 degrees
+                cv::Mat renderRoi = lenTypeRenderCanvas(roi);
+                cv::Mat weightRoi = lenTypeWeightCanvas(roi);
+                if (params.directRender) {
+                    blender.blend(src, arrange_.getDirection(), patchCenter, patchWidth, !arrange_.isKepler(),
+                                  gradBlendingWeight, 1.f, renderRoi, weightRoi);
+                } else {
+                    const cv::Mat& patch = getRoiImageByCenter(src, patchCenter, patchWidth);
+                    blender.blend(patch, !arrange_.isKepler(), gradBlendingWeight, 1.f, renderRoi, weightRoi);
+                }
             }
         }
 
-        cv::Mat croppedRenderCanvas = mvCache_.renderCanvas(params_.canvasCropRoi);
-        cv::multiply(croppedRenderCanvas, lenTypeWeights[lenType], croppedRenderCanvas);
+        cv::Mat croppedRenderCanvas = lenTypeRenderCanvas(params.canvasCropRoi);
+        cv::multiply(croppedRenderCanvas, scaledLenTypeWeights[lenType], croppedRenderCanvas);
         renderCanvas += croppedRenderCanvas;
 
-        cv::Mat croppedWeightCanvas = mvCache_.weightCanvas(params_.canvasCropRoi);
-        cv::multiply(croppedWeightCanvas, lenTypeWeights[lenType], croppedWeightCanvas);
+        cv::Mat croppedWeightCanvas = lenTypeWeightCanvas(params.canvasCropRoi);
+        cv::multiply(croppedWeightCanvas, scaledLenTypeWeights[lenType], croppedWeightCanvas);
         weightCanvas += croppedWeightCanvas;
     }
 
-    cv::divide(renderCanvas, weightCanvas, mvCache_.u8NormedImage, 1, CV_8UC1);
-    cv::resize(mvCache_.u8NormedImage, dst, dstSize, 0.0, 0.0, cv::INTER_CUBIC);
+    // Normalize, restore the native orientation and downscale straight into the output plane
+    cv::divide(1.0, weightCanvas, weightCanvas);
+    normalizeResize(renderCanvas, weightCanvas, dst, dstSize, arrange_.getDirection(), maxValue);
 
     return {};
 }
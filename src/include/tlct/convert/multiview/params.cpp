@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 
@@ -45,8 +46,52 @@ auto MvParams_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtC
     const int outputWidth = _hp::roundTo<2>(_hp::iround((float)colRange.size() / upsample));
     const int outputHeight = _hp::roundTo<2>(_hp::iround((float)rowRange.size() / upsample));
 
-    return MvParams_{{rowRange, colRange}, psizeInflate, cvtCfg.views, maxPsize,     patchXShift, patchYShift,
-                     resizedPatchWdt,      viewInterval, canvasWidth,  canvasHeight, outputWidth, outputHeight};
+    const MvParams_ params{{rowRange, colRange}, psizeInflate, cvtCfg.views, maxPsize,     patchXShift, patchYShift,
+                           resizedPatchWdt,      viewInterval, canvasWidth,  canvasHeight, outputWidth, outputHeight,
+                           1.f,                  false};
+
+    if (cvtCfg.directRender) {
+        // The canvas is laid out at output resolution, the source is sampled at its native one
+        MvParams_ directParams = params.rescaled(1.f / (float)upsample);
+        directParams.directRender = true;
+        return directParams;
+    }
+
+    return params;
+}
+
+template <cfg::concepts::CArrange TArrange>
+MvParams_<TArrange> MvParams_<TArrange>::scaled(const int shift) const noexcept {
+    if (shift == 0) return *this;
+
+    MvParams_ params = rescaled(1.f / (float)(1 << shift));
+    params.outputWidth = outputWidth >> shift;
+    params.outputHeight = outputHeight >> shift;
+
+    return params;
+}
+
+template <cfg::concepts::CArrange TArrange>
+MvParams_<TArrange> MvParams_<TArrange>::rescaled(const float scale) const noexcept {
+    MvParams_ params = *this;
+
+    params.maxPsize *= scale;
+    params.patchXShift *= scale;
+    params.patchYShift *= scale;
+    params.resizedPatchWidth = _hp::iround(resizedPatchWidth * scale);
+    params.viewInterval *= scale;
+    params.renderScale *= scale;
+
+    // One extra pixel to hold the rounding of the pasting position
+    params.canvasWidth = std::min((int)std::ceil(canvasWidth * scale) + 1, canvasWidth);
+    params.canvasHeight = std::min((int)std::ceil(canvasHeight * scale) + 1, canvasHeight);
+
+    for (const int i : {0, 1}) {
+        params.canvasCropRoi[i] = {(int)std::ceil(canvasCropRoi[i].start * scale),
+                                   (int)(canvasCropRoi[i].end * scale)};
+    }
+
+    return params;
 }
 
 template class MvParams_<cfg::CornersArrange>;
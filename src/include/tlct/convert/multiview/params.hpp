@@ -20,7 +20,13 @@ public:
     [[nodiscard]] TLCT_API static std::expected<MvParams_, Error> create(const TArrange& arrange,
                                                                          const TCvtConfig& cvtCfg) noexcept;
 
+    // Const methods
     [[nodiscard]] cv::Size getRoiSize() const noexcept { return {canvasCropRoi[1].size(), canvasCropRoi[0].size()}; }
+    // Geometry of a plane subsampled by `1 << shift`, e.g. the chroma planes of yuv420p.
+    // The canvas is shrunk accordingly and never exceeds the luma one.
+    [[nodiscard]] TLCT_API MvParams_ scaled(int shift) const noexcept;
+    // Geometry on a render grid `scale` times the current one, the output size is kept
+    [[nodiscard]] TLCT_API MvParams_ rescaled(float scale) const noexcept;
 
     cv::Range canvasCropRoi[2];
     float psizeInflate;
@@ -34,6 +40,10 @@ public:
     int canvasHeight;
     int outputWidth;
     int outputHeight;
+    // Maps the grid of `TArrange` onto the render grid, below 1 for subsampled planes or in direct render mode
+    float renderScale;
+    // Patches are sampled at sub-pixel positions of the native resolution source
+    bool directRender;
 };
 
 }  // namespace tlct::_cvt
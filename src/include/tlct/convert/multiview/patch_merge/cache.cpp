@@ -14,15 +14,13 @@
 namespace tlct::_cvt::pm {
 
 template <cfg::concepts::CArrange TArrange>
-MvCache_<TArrange>::MvCache_(cv::Mat&& renderCanvas, cv::Mat&& weightCanvas) noexcept
-    : renderCanvas(std::move(renderCanvas)), weightCanvas(std::move(weightCanvas)) {}
+MvCache_<TArrange>::MvCache_(cv::Mat&& renderCanvas) noexcept : renderCanvas(std::move(renderCanvas)) {}
 
 template <cfg::concepts::CArrange TArrange>
 auto MvCache_<TArrange>::create(const TMvParams& params) noexcept -> std::expected<MvCache_, Error> {
     try {
         cv::Mat renderCanvas{cv::Size{params.canvasWidth, params.canvasHeight}, CV_32FC1};
-        cv::Mat weightCanvas{cv::Size{params.canvasWidth, params.canvasHeight}, CV_32FC1};
-        return MvCache_{std::move(renderCanvas), std::move(weightCanvas)};
+        return MvCache_{std::move(renderCanvas)};
     } catch (const std::bad_alloc&) {
         return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
     }
@@ -16,7 +16,7 @@ public:
     using TMvParams = MvParams_<TArrange>;
 
 private:
-    MvCache_(cv::Mat&& renderCanvas, cv::Mat&& weightCanvas) noexcept;
+    MvCache_(cv::Mat&& renderCanvas) noexcept;
 
 public:
     // Constructor
@@ -30,10 +30,6 @@ public:
     [[nodiscard]] TLCT_API static std::expected<MvCache_, Error> create(const TMvParams& params) noexcept;
 
     cv::Mat renderCanvas;
-    cv::Mat weightCanvas;
-
-    cv::Mat f32Chan;
-    cv::Mat u8NormedImage;
 };
 
 }  // namespace tlct::_cvt::pm
@@ -18,8 +18,12 @@ namespace rgs = std::ranges;
 
 template <cfg::concepts::CArrange TArrange>
 MvImpl_<TArrange>::MvImpl_(const TArrange& arrange, const TMvParams& params, TMvCache&& cache,
-                           std::shared_ptr<TCommonCache>&& pCommonCache) noexcept
-    : arrange_(arrange), params_(params), mvCache_(std::move(cache)), pCommonCache_(pCommonCache) {}
+                           CircleMaskBank&& blendMasks, std::shared_ptr<TCommonCache>&& pCommonCache) noexcept
+    : arrange_(arrange),
+      params_(params),
+      pCommonCache_(pCommonCache),
+      mvCache_(std::move(cache)),
+      blendMasks_(std::move(blendMasks)) {}
 
 template <cfg::concepts::CArrange TArrange>
 auto MvImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtCfg,
@@ -32,7 +36,17 @@ auto MvImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtCfg
     if (!mvCacheRes) return std::unexpected{std::move(mvCacheRes.error())};
     auto& mvCache = mvCacheRes.value();
 
-    return MvImpl_{arrange, params, std::move(mvCache), std::move(pCommonCache)};
+    // Every patch is resized to at most `resizedPatchWidth`, plus one for the rounding of `psize * inflate / psize`
+    auto blendMasksRes = CircleMaskBank::create(params.resizedPatchWidth + 1, 0.0f, 1.0f);
+    if (!blendMasksRes) return std::unexpected{std::move(blendMasksRes.error())};
+    auto& blendMasks = blendMasksRes.value();
+
+    return MvImpl_{arrange, params, std::move(mvCache), std::move(blendMasks), std::move(pCommonCache)};
+}
+
+template <cfg::concepts::CArrange TArrange>
+auto MvImpl_<TArrange>::createCache() const noexcept -> std::expected<TMvCache, Error> {
+    return TMvCache::create(params_);
 }
 
 static_assert(concepts::CMvImpl<MvImpl_<cfg::CornersArrange>, PatchMergeBridge_<cfg::CornersArrange>>);
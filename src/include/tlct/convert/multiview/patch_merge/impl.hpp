@@ -1,6 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <limits>
+#include <new>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include <opencv2/imgproc.hpp>
 
@@ -26,12 +35,12 @@ public:
     using TCvtConfig = cfg::CliConfig::Convert;
     using TArrange = TArrange_;
     using TCommonCache = CommonCache_<TArrange>;
+    using TMvCache = MvCache_<TArrange>;
 
 private:
     using TMvParams = MvParams_<TArrange>;
-    using TMvCache = MvCache_<TArrange>;
 
-    MvImpl_(const TArrange& arrange, const TMvParams& params, TMvCache&& cache,
+    MvImpl_(const TArrange& arrange, const TMvParams& params, TMvCache&& cache, CircleMaskBank&& blendMasks,
             std::shared_ptr<TCommonCache>&& pCommonCache) noexcept;
 
 public:
@@ -51,51 +60,211 @@ public:
         return {params_.outputWidth, params_.outputHeight};
     }
 
+    // Scratch buffers for rendering, one per view in flight
+    [[nodiscard]] TLCT_API std::expected<TMvCache, Error> createCache() const noexcept;
+
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
+                                                        int viewCol) const noexcept {
+        return renderView(bridge, dst, viewRow, viewCol, mvCache_);
+    }
     template <concepts::CPatchMergeBridge TBridge>
     [[nodiscard]] std::expected<void, Error> renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
-                                                        int viewCol) const noexcept;
+                                                        int viewCol, TMvCache& cache) const noexcept {
+        const cv::Point viewIndex{viewCol, viewRow};
+        return renderViews(bridge, {&dst, 1}, {&viewIndex, 1}, {&cache, 1});
+    }
+    // Renders the view `viewIndices[i]` ({viewCol, viewRow}) into `dsts[i]` using `caches[i]`.
+    // Each MI is visited once and scattered into all the view canvases.
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderViews(const TBridge& bridge, std::span<io::YuvPlanarFrame> dsts,
+                                                         std::span<const cv::Point> viewIndices,
+                                                         std::span<TMvCache> caches) const noexcept;
+    // Renders only the window `roi` of the output view into `dst`, which has the size of `roi`.
+    // Only the MIs reaching that window are pasted, so the cost follows the window area instead of the sensor size.
+    // `roi` must be aligned to the chroma subsampling.
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderViewRoi(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
+                                                           int viewCol, cv::Rect roi) const noexcept;
+
+    // Non-const methods
+    // Must be called once the bridge of a new frame is ready and before any rendering of that frame
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> updateWeights(const TBridge& bridge) noexcept;
 
 private:
+    struct PatchGeometry {
+        float width;   // width of the patch extracted from the source plane
+        cv::Rect roi;  // where the resized patch is pasted on the canvas
+    };
+
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] PatchGeometry getPatchGeometry(const TBridge& bridge, const TMvParams& params, int row,
+                                                 int col) const noexcept;
+
+    // Pastes the MIs reaching `window` onto `canvases`, whose top-left pixel lies at `canvasOrigin` of the canvas
     template <concepts::CPatchMergeBridge TBridge>
-    [[nodiscard]] std::expected<void, Error> renderChan(const TBridge& bridge, const cv::Mat& src, cv::Mat& dst,
-                                                        cv::Size dstSize, int viewRow, int viewCol) const noexcept;
+    void pasteChan(const TBridge& bridge, int chanIdx, std::span<const cv::Point> viewIndices,
+                   std::span<cv::Mat> canvases, cv::Point canvasOrigin, cv::Rect window) const;
+
+    template <concepts::CPatchMergeBridge TBridge>
+    [[nodiscard]] std::expected<void, Error> renderChan(const TBridge& bridge, int chanIdx,
+                                                        std::span<io::YuvPlanarFrame> dsts,
+                                                        std::span<const cv::Point> viewIndices,
+                                                        std::span<TMvCache> caches) const noexcept;
+
+    template <concepts::CPatchMergeBridge TBridge>
+    void renderChanRoi(const TBridge& bridge, int chanIdx, cv::Mat& dst, int maxValue, cv::Point viewIndex,
+                       cv::Rect roi) const;
 
     TArrange arrange_;
     TMvParams params_;
     std::shared_ptr<TCommonCache> pCommonCache_;
     mutable TMvCache mvCache_;
+    CircleMaskBank blendMasks_;
+    // The normalization weights only depend on the bridge, so they are built once per frame
+    cv::Mat weightCanvas_;
+    std::array<cv::Mat, TCommonCache::CHANNELS> recipWeights_;
 };
 
 template <cfg::concepts::CArrange TArrange>
 template <concepts::CPatchMergeBridge TBridge>
-std::expected<void, Error> MvImpl_<TArrange>::renderView(const TBridge& bridge, io::YuvPlanarFrame& dst, int viewRow,
-                                                         int viewCol) const noexcept {
-    // TODO: handle `std::bad_alloc` in this func
-    std::array<std::reference_wrapper<cv::Mat>, TCommonCache::CHANNELS> channels{
-        std::ref(dst.getY()), std::ref(dst.getU()), std::ref(dst.getV())};
-    const io::YuvPlanarExtent& frameExtent = dst.getExtent();
-    std::array<cv::Size, TCommonCache::CHANNELS> channelSizes{
-        frameExtent.getYSize(),
-        frameExtent.getUSize(),
-        frameExtent.getVSize(),
-    };
+auto MvImpl_<TArrange>::getPatchGeometry(const TBridge& bridge, const TMvParams& params, const int row,
+                                         const int col) const noexcept -> PatchGeometry {
+    const float psize = bridge.getPatchsize(row, col) * params.renderScale;
+    const float patchWidth = std::min(psize * params.psizeInflate, params.maxPsize);
+    const float psizeInflate = patchWidth / psize;
+    // Patch sizes may come from a loaded bridge container
+    const int resizedPatchWidth =
+        std::clamp(_hp::iround(psizeInflate * params.patchXShift), 0, blendMasks_.getMaxDiameter());
+
+    // if the second bar is not out shift, then we need to shift the 1 col
+    // else if the second bar is out shift, then we need to shift the 0 col
+    const float rightShift = ((row % 2) ^ (int)arrange_.isOutShift()) * (params.patchXShift / 2);
+    const cv::Rect roi{_hp::iround(col * params.patchXShift + rightShift), _hp::iround(row * params.patchYShift),
+                       resizedPatchWidth, resizedPatchWidth};
+
+    return {patchWidth, roi};
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+std::expected<void, Error> MvImpl_<TArrange>::updateWeights(const TBridge& bridge) noexcept {
+    try {
+        weightCanvas_.create(params_.canvasHeight, params_.canvasWidth, CV_32FC1);
+
+        for (const int chanIdx : rgs::views::iota(0, TCommonCache::CHANNELS)) {
+            // Planes with the same subsampling share the same weights, e.g. U and V
+            const auto& shifts = pCommonCache_->shifts;
+            const int shift = shifts[chanIdx];
+            const auto sharedIt = rgs::find(shifts.begin(), shifts.begin() + chanIdx, shift);
+            if (sharedIt != shifts.begin() + chanIdx) {
+                recipWeights_[chanIdx] = recipWeights_[sharedIt - shifts.begin()];
+                continue;
+            }
 
-    if (arrange_.getDirection()) {
-        for (auto& channelSize : channelSizes) {
-            std::swap(channelSize.width, channelSize.height);
+            const TMvParams params = params_.scaled(shift);
+            cv::Mat weightCanvas = weightCanvas_({0, 0, params.canvasWidth, params.canvasHeight});
+            weightCanvas.setTo(std::numeric_limits<float>::epsilon());
+
+            // Same band layout as `renderChan`
+            const int miRows = arrange_.getMIRows();
+            const int bandMIRows =
+                std::max(2, (int)std::ceil((float)(params.resizedPatchWidth + 1) / params.patchYShift));
+            const int bandCount = (miRows + bandMIRows - 1) / bandMIRows;
+
+            for (const int parity : {0, 1}) {
+#pragma omp parallel for schedule(dynamic)
+                for (int bandIdx = parity; bandIdx < bandCount; bandIdx += 2) {
+                    const int rowEnd = std::min((bandIdx + 1) * bandMIRows, miRows);
+                    for (int row = bandIdx * bandMIRows; row < rowEnd; row++) {
+                        for (const int col : rgs::views::iota(0, arrange_.getMICols(row))) {
+                            const PatchGeometry geometry = getPatchGeometry(bridge, params, row, col);
+                            const cv::Mat& blendMask = blendMasks_.get(geometry.roi.width);
+                            cv::Mat weightRoi = weightCanvas(geometry.roi);
+                            if (arrange_.isMultiFocus()) {
+                                cv::scaleAdd(blendMask, bridge.getWeight(row, col), weightRoi, weightRoi);
+                            } else {
+                                weightRoi += blendMask;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // A fresh buffer each frame, the previous one may be shared with another plane
+            cv::Mat recipWeight;
+            cv::divide(1.0, weightCanvas(params.canvasCropRoi), recipWeight);
+            recipWeights_[chanIdx] = std::move(recipWeight);
         }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    return {};
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+std::expected<void, Error> MvImpl_<TArrange>::renderViews(const TBridge& bridge, std::span<io::YuvPlanarFrame> dsts,
+                                                          std::span<const cv::Point> viewIndices,
+                                                          std::span<TMvCache> caches) const noexcept {
+    if (dsts.size() != viewIndices.size() || caches.size() < viewIndices.size()) [[unlikely]] {
+        auto errMsg = std::format("expect a dst frame and a cache per view, got {} frames, {} caches for {} views",
+                                  dsts.size(), caches.size(), viewIndices.size());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    if (viewIndices.empty()) return {};
+    if (recipWeights_[0].empty()) [[unlikely]] {
+        return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, "weights are not updated for this frame"}};
     }
 
     for (const int chanIdx : rgs::views::iota(0, TCommonCache::CHANNELS)) {
-        auto renderChanRes = renderChan(bridge, pCommonCache_->srcs[chanIdx], channels[chanIdx], channelSizes[chanIdx],
-                                        viewRow, viewCol);
+        auto renderChanRes = renderChan(bridge, chanIdx, dsts, viewIndices, caches);
         if (!renderChanRes) return std::unexpected{std::move(renderChanRes.error())};
     }
 
-    if (arrange_.getDirection()) {
-        cv::transpose(dst.getY(), dst.getY());
-        cv::transpose(dst.getU(), dst.getU());
-        cv::transpose(dst.getV(), dst.getV());
+    return {};
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+std::expected<void, Error> MvImpl_<TArrange>::renderViewRoi(const TBridge& bridge, io::YuvPlanarFrame& dst,
+                                                            const int viewRow, const int viewCol,
+                                                            const cv::Rect roi) const noexcept {
+    // In the native orientation, like `dst`
+    const cv::Size outputSize =
+        arrange_.getDirection() ? cv::Size{params_.outputHeight, params_.outputWidth} : getOutputSize();
+    if (roi.empty() || roi.x < 0 || roi.y < 0 || roi.x + roi.width > outputSize.width ||
+        roi.y + roi.height > outputSize.height) [[unlikely]] {
+        auto errMsg = std::format("roi ({}, {}, {}x{}) is empty or exceeds the output size {}x{}", roi.x, roi.y,
+                                  roi.width, roi.height, outputSize.width, outputSize.height);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    const int alignment = 1 << rgs::max(pCommonCache_->shifts);
+    if (roi.x % alignment || roi.y % alignment || roi.width % alignment || roi.height % alignment) [[unlikely]] {
+        auto errMsg = std::format("roi ({}, {}, {}x{}) must be aligned to {}", roi.x, roi.y, roi.width, roi.height,
+                                  alignment);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    if (dst.getExtent().getYSize() != roi.size()) [[unlikely]] {
+        auto errMsg = std::format("expect a dst frame of {}x{}, got {}x{}", roi.width, roi.height,
+                                  dst.getExtent().getYWidth(), dst.getExtent().getYHeight());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    if (recipWeights_[0].empty()) [[unlikely]] {
+        return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, "weights are not updated for this frame"}};
+    }
+
+    try {
+        const std::array<std::reference_wrapper<cv::Mat>, TCommonCache::CHANNELS> dstChannels{
+            std::ref(dst.getY()), std::ref(dst.getU()), std::ref(dst.getV())};
+        const int maxValue = (1 << dst.getExtent().getBitDepth()) - 1;
+        for (const int chanIdx : rgs::views::iota(0, TCommonCache::CHANNELS)) {
+            renderChanRoi(bridge, chanIdx, dstChannels[chanIdx], maxValue, {viewCol, viewRow}, roi);
+        }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
     }
 
     return {};
@@ -103,68 +272,154 @@ std::expected<void, Error> MvImpl_<TArrange>::renderView(const TBridge& bridge,
 
 template <cfg::concepts::CArrange TArrange>
 template <concepts::CPatchMergeBridge TBridge>
-std::expected<void, Error> MvImpl_<TArrange>::renderChan(const TBridge& bridge, const cv::Mat& src, cv::Mat& dst,
-                                                         cv::Size dstSize, int viewRow, int viewCol) const noexcept {
-    const float viewShiftX = (viewCol - params_.views / 2) * params_.viewInterval;
-    const float viewShiftY = (viewRow - params_.views / 2) * params_.viewInterval;
-
-    mvCache_.renderCanvas.setTo(std::numeric_limits<float>::epsilon());
-    mvCache_.weightCanvas.setTo(std::numeric_limits<float>::epsilon());
-    src.convertTo(mvCache_.f32Chan, CV_32FC1);
-
-    cv::Mat resizedPatch;
-    cv::Mat rotatedPatch;
-    cv::Mat blendedPatch;
-
-    for (const int row : rgs::views::iota(0, arrange_.getMIRows())) {
-        for (const int col : rgs::views::iota(0, arrange_.getMICols(row))) {
-            // Extract patch
-            const cv::Point2f center = arrange_.getMICenter(row, col);
-            const float psize = bridge.getPatchsize(row, col);
-            const float patchWidth = std::min(psize * params_.psizeInflate, params_.maxPsize);
-            const float psizeInflate = patchWidth / psize;
-            const int resizedPatchWidth = _hp::iround(psizeInflate * params_.patchXShift);
-            const cv::Point2f patchCenter{center.x + viewShiftX, center.y + viewShiftY};
-            const cv::Mat& patch = getRoiImageByCenter(mvCache_.f32Chan, patchCenter, patchWidth);
-
-            // Paste patch
-            if (arrange_.isKepler()) {
-                cv::resize(patch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0, cv::INTER_CUBIC);
-            } else {
-                cv::rotate(patch, rotatedPatch, cv::ROTATE_180);
-                cv::resize(rotatedPatch, resizedPatch, {resizedPatchWidth, resizedPatchWidth}, 0, 0, cv::INTER_CUBIC);
-            }
+void MvImpl_<TArrange>::pasteChan(const TBridge& bridge, const int chanIdx, std::span<const cv::Point> viewIndices,
+                                  std::span<cv::Mat> canvases, const cv::Point canvasOrigin,
+                                  const cv::Rect window) const {
+    const int viewCount = (int)viewIndices.size();
+
+    // Subsampled planes are rendered on their own grid with the MI geometry scaled down
+    const int shift = pCommonCache_->shifts[chanIdx];
+    const TMvParams params = params_.scaled(shift);
+    const float scale = params.renderScale;
+    // Maps pixel centers of the arrange grid onto the grid of this plane, zero when both grids match
+    const float centerBias = 0.5f * scale - 0.5f;
+
+    const auto getViewShift = [&](const int viewIdx) {
+        const cv::Point viewIndex = viewIndices[viewIdx];
+        return cv::Point2f{(viewIndex.x - params.views / 2) * params.viewInterval,
+                           (viewIndex.y - params.views / 2) * params.viewInterval};
+    };
 
-            cv::Mat gradBlendingWeight = circleWithFadeoutBorder(resizedPatchWidth, 0.0f, 1.0f);
-            cv::multiply(resizedPatch, gradBlendingWeight, blendedPatch);
-
-            // if the second bar is not out shift, then we need to shift the 1 col
-            // else if the second bar is out shift, then we need to shift the 0 col
-            const float rightShift = ((row % 2) ^ (int)arrange_.isOutShift()) * (params_.patchXShift / 2);
-            const cv::Rect roi{_hp::iround(col * params_.patchXShift + rightShift),
-                               _hp::iround(row * params_.patchYShift), resizedPatchWidth, resizedPatchWidth};
-
-            if (arrange_.isMultiFocus()) {
-                const float weight = bridge.getWeight(row, col);
-                cv::addWeighted(mvCache_.renderCanvas(roi), 1.f, blendedPatch, weight, 0.f, mvCache_.renderCanvas(roi));
-                cv::addWeighted(mvCache_.weightCanvas(roi), 1.f, gradBlendingWeight, weight, 0.f,
-                                mvCache_.weightCanvas(roi));
-            } else {
-                mvCache_.renderCanvas(roi) += blendedPatch;
-                mvCache_.weightCanvas(roi) += gradBlendingWeight;
+    const cv::Mat& f32Src = pCommonCache_->f32Srcs[chanIdx];
+
+    // Only the MIs whose patch may reach the window, the exact test is done per MI
+    const int miRows = arrange_.getMIRows();
+    const float reach = (float)params.resizedPatchWidth + 2.f;
+    const int rowBegin = std::max(0, (int)std::floor((window.y - reach) / params.patchYShift));
+    const int rowEnd = std::min(miRows, (int)std::ceil((window.y + window.height + 1) / params.patchYShift));
+    const int colBegin = std::max(0, (int)std::floor((window.x - reach) / params.patchXShift) - 1);
+    const int colEnd = (int)std::ceil((window.x + window.width + 1) / params.patchXShift);
+
+    // Bands of whole MI rows, tall enough that the patches of one band never reach the band after next.
+    // Even bands run before odd ones, so concurrent bands never write the same canvas rows and the
+    // accumulation order does not depend on the thread count.
+    const int bandMIRows = std::max(2, (int)std::ceil((float)(params.resizedPatchWidth + 1) / params.patchYShift));
+    const int bandBegin = rowBegin / bandMIRows;
+    const int bandEnd = (rowEnd + bandMIRows - 1) / bandMIRows;
+
+    for (const int parity : {0, 1}) {
+#pragma omp parallel
+        {
+            PatchBlender blender;
+            cv::Mat noWeightCanvas;
+
+#pragma omp for schedule(dynamic)
+            for (int bandIdx = bandBegin + ((bandBegin + parity) & 1); bandIdx < bandEnd; bandIdx += 2) {
+                const int bandRowEnd = std::min((bandIdx + 1) * bandMIRows, rowEnd);
+                for (int row = std::max(bandIdx * bandMIRows, rowBegin); row < bandRowEnd; row++) {
+                    const int rowColEnd = std::min(colEnd, arrange_.getMICols(row));
+                    for (int col = colBegin; col < rowColEnd; col++) {
+                        // View-independent geometry
+                        const auto [patchWidth, roi] = getPatchGeometry(bridge, params, row, col);
+                        if ((roi & window).empty()) continue;
+                        const cv::Point2f center = arrange_.getMICenter(row, col);
+                        const cv::Point2f planeCenter{center.x * scale + centerBias, center.y * scale + centerBias};
+                        const cv::Rect canvasRoi = roi - canvasOrigin;
+                        const cv::Mat& blendMask = blendMasks_.get(roi.width);
+                        const float weight = arrange_.isMultiFocus() ? bridge.getWeight(row, col) : 1.f;
+
+                        // Only the extraction depends on the view
+                        for (const int viewIdx : rgs::views::iota(0, viewCount)) {
+                            const cv::Point2f patchCenter = planeCenter + getViewShift(viewIdx);
+                            cv::Mat renderRoi = canvases[viewIdx](canvasRoi);
+                            // Galilean MIs are rotated by 180 degrees
+                            if (params.directRender) {
+                                blender.blend(f32Src, arrange_.getDirection(), patchCenter, patchWidth,
+                                              !arrange_.isKepler(), blendMask, weight, renderRoi, noWeightCanvas);
+                            } else {
+                                const cv::Mat& patch = getRoiImageByCenter(f32Src, patchCenter, patchWidth);
+                                blender.blend(patch, !arrange_.isKepler(), blendMask, weight, renderRoi,
+                                              noWeightCanvas);
+                            }
+                        }
+                    }
+                }
             }
         }
     }
+}
 
-    cv::Mat croppedRenderCanvas = mvCache_.renderCanvas(params_.canvasCropRoi);
-    cv::Mat croppedWeightCanvas = mvCache_.weightCanvas(params_.canvasCropRoi);
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+std::expected<void, Error> MvImpl_<TArrange>::renderChan(const TBridge& bridge, const int chanIdx,
+                                                         std::span<io::YuvPlanarFrame> dsts,
+                                                         std::span<const cv::Point> viewIndices,
+                                                         std::span<TMvCache> caches) const noexcept {
+    const int viewCount = (int)viewIndices.size();
+    const TMvParams params = params_.scaled(pCommonCache_->shifts[chanIdx]);
+
+    const cv::Rect canvasRoi{0, 0, params.canvasWidth, params.canvasHeight};
+    std::vector<cv::Mat> canvases;
+    try {
+        canvases.reserve(viewCount);
+        for (const int viewIdx : rgs::views::iota(0, viewCount)) {
+            cv::Mat canvas = caches[viewIdx].renderCanvas(canvasRoi);
+            canvas.setTo(std::numeric_limits<float>::epsilon());
+            canvases.push_back(std::move(canvas));
+        }
+        pasteChan(bridge, chanIdx, viewIndices, canvases, {0, 0}, canvasRoi);
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
 
-    cv::divide(croppedRenderCanvas, croppedWeightCanvas, mvCache_.u8NormedImage, 1, CV_8UC1);
-    cv::resize(mvCache_.u8NormedImage, dst, dstSize, 0.0, 0.0, cv::INTER_CUBIC);
+    const cv::Mat& recipWeight = recipWeights_[chanIdx];
+
+#pragma omp parallel for
+    for (int viewIdx = 0; viewIdx < viewCount; viewIdx++) {
+        io::YuvPlanarFrame& dstFrame = dsts[viewIdx];
+        const std::array<std::reference_wrapper<cv::Mat>, TCommonCache::CHANNELS> dstChannels{
+            std::ref(dstFrame.getY()), std::ref(dstFrame.getU()), std::ref(dstFrame.getV())};
+        const std::array<cv::Size, TCommonCache::CHANNELS> dstSizes{
+            dstFrame.getExtent().getYSize(), dstFrame.getExtent().getUSize(), dstFrame.getExtent().getVSize()};
+        cv::Mat& dst = dstChannels[chanIdx];
+
+        // Normalize, restore the native orientation and downscale straight into the output plane
+        const cv::Mat croppedRenderCanvas = canvases[viewIdx](params.canvasCropRoi);
+        const int maxValue = (1 << dstFrame.getExtent().getBitDepth()) - 1;
+        normalizeResize(croppedRenderCanvas, recipWeight, dst, dstSizes[chanIdx], arrange_.getDirection(), maxValue);
+    }
 
     return {};
 }
 
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CPatchMergeBridge TBridge>
+void MvImpl_<TArrange>::renderChanRoi(const TBridge& bridge, const int chanIdx, cv::Mat& dst, const int maxValue,
+                                      const cv::Point viewIndex, const cv::Rect roi) const {
+    const int shift = pCommonCache_->shifts[chanIdx];
+    const TMvParams params = params_.scaled(shift);
+    const bool transposed = arrange_.getDirection();
+
+    // The window on this plane, and the part of the cropped canvas reached by its resampling taps
+    const cv::Rect planeRoi{roi.x >> shift, roi.y >> shift, roi.width >> shift, roi.height >> shift};
+    const cv::Size planeSize = transposed ? cv::Size{params.outputHeight, params.outputWidth}
+                                          : cv::Size{params.outputWidth, params.outputHeight};
+    const cv::Size cropSize = params.getRoiSize();
+    const cv::Rect cropWindow = getResizeSrcRoi(cropSize, planeRoi, planeSize, transposed);
+    const cv::Rect window = cropWindow + cv::Point{params.canvasCropRoi[1].start, params.canvasCropRoi[0].start};
+
+    // The patches reaching the window stick out of it by less than the largest mask
+    const int margin = blendMasks_.getMaxDiameter();
+    cv::Mat canvas{window.height + 2 * margin, window.width + 2 * margin, CV_32FC1,
+                   cv::Scalar::all(std::numeric_limits<float>::epsilon())};
+    pasteChan(bridge, chanIdx, {&viewIndex, 1}, {&canvas, 1}, window.tl() - cv::Point{margin, margin}, window);
+
+    // The weights are complete for every pixel of the window, unlike the canvas margins
+    const cv::Mat windowCanvas = canvas({cv::Point{margin, margin}, window.size()});
+    normalizeResize(windowCanvas, recipWeights_[chanIdx](cropWindow), cropWindow.tl(), cropSize, dst, planeRoi,
+                    planeSize, transposed, maxValue);
+}
+
 }  // namespace tlct::_cvt::pm
 
 #ifdef _TLCT_LIB_HEADER_ONLY
@@ -1,8 +1,17 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <immintrin.h>
 #include <opencv2/core.hpp>
 
+#include "tlct/helper/constexpr/math.hpp"
 #include "tlct/helper/std.hpp"
 
 #ifndef _TLCT_LIB_HEADER_ONLY
@@ -13,11 +22,29 @@ namespace tlct::_cvt::census {
 
 namespace rgs = std::ranges;
 
-void censusTransform5x5(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& censusMap, cv::Mat& censusMask) noexcept {
-    assert(src.type() == CV_8UC1);
+static constexpr int CENSUS_WINDOW = 5;
+static constexpr int CENSUS_HALF_WINDOW = CENSUS_WINDOW / 2;
+static constexpr int CENSUS_BITS = CENSUS_WINDOW * CENSUS_WINDOW - 1;
+
+// {row, col} offsets of the window pixels, in the order of the signature bits
+static constexpr auto CENSUS_OFFSETS = [] {
+    std::array<std::pair<int, int>, CENSUS_BITS> offsets{};
+    int bitIdx = 0;
+    for (int winRow = -CENSUS_HALF_WINDOW; winRow <= CENSUS_HALF_WINDOW; winRow++) {
+        for (int winCol = -CENSUS_HALF_WINDOW; winCol <= CENSUS_HALF_WINDOW; winCol++) {
+            if (winRow == 0 && winCol == 0) continue;
+            offsets[bitIdx++] = {winRow, winCol};
+        }
+    }
+    return offsets;
+}();
+
+template <typename TPix>
+inline void censusTransform5x5RefImpl(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& censusMap,
+                                      cv::Mat& censusMask) noexcept {
     assert(srcMask.type() == CV_8UC1);
-    assert(censusMap.elemSize() == 3);
-    assert(censusMask.elemSize() == 3);
+    assert(censusMap.type() == CV_32SC1);
+    assert(censusMask.type() == CV_32SC1);
 
     const auto isInRange = [&src](const int row, const int col) {
         if (row < 0 || row >= src.rows) [[unlikely]]
@@ -28,36 +55,30 @@ void censusTransform5x5(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& cen
     };
 
     for (const int row : rgs::views::iota(0, src.rows)) {
-        cv::Vec3b* pCsMap = censusMap.ptr<cv::Vec3b>(row);
-        cv::Vec3b* pCsMask = censusMask.ptr<cv::Vec3b>(row);
+        uint32_t* pCsMap = censusMap.ptr<uint32_t>(row);
+        uint32_t* pCsMask = censusMask.ptr<uint32_t>(row);
         for (const int col : rgs::views::iota(0, src.cols)) {
             // For each pixel
             constexpr int WINDOW = 5;
             constexpr int HALF_WINDOW = WINDOW / 2;
+            *pCsMap = 0;
+            *pCsMask = 0;
             // Deal with the window
             int winPixCount = 0;
-            const uint8_t centralPix = src.at<uint8_t>(row, col);
+            const TPix centralPix = src.at<TPix>(row, col);
             for (int winRow = -HALF_WINDOW; winRow <= HALF_WINDOW; winRow++) {
                 for (int winCol = -HALF_WINDOW; winCol <= HALF_WINDOW; winCol++) {
                     if (winRow == 0 && winCol == 0) [[unlikely]]
                         continue;  // skip the central pixel
 
-                    const int byteId = winPixCount / 8;
-                    const int bitOffset = winPixCount % 8;
-                    constexpr uint8_t one = 1;
-                    if (!isInRange(row + winRow, col + winCol)) [[unlikely]] {
-                        (*pCsMask)[byteId] &= ~(one << bitOffset);  // bit set pMask[vecIdx][vecShift] = 0
-                    } else {
+                    const uint32_t bit = 1u << winPixCount;
+                    if (isInRange(row + winRow, col + winCol)) [[likely]] {
                         const uint8_t srcMaskVal = srcMask.at<uint8_t>(row + winRow, col + winCol);
-                        if (srcMaskVal == 0) [[unlikely]] {
-                            (*pCsMask)[byteId] &= ~(one << bitOffset);  // bit set pMask[vecIdx][vecShift] = 0
-                        } else {
-                            const uint8_t srcPix = src.at<uint8_t>(row + winRow, col + winCol);
-                            (*pCsMask)[byteId] |= (one << bitOffset);  // bit set pMask[vecIdx][vecShift] = 1
+                        if (srcMaskVal != 0) [[likely]] {
+                            const TPix srcPix = src.at<TPix>(row + winRow, col + winCol);
+                            *pCsMask |= bit;
                             if (srcPix > centralPix) {
-                                (*pCsMap)[byteId] |= (one << bitOffset);  // bit set pMap[vecIdx][vecShift] = 1
-                            } else {
-                                (*pCsMap)[byteId] &= ~(one << bitOffset);  // bit set pMap[vecIdx][vecShift] = 1
+                                *pCsMap |= bit;
                             }
                         }
                     }
@@ -72,4 +93,131 @@ void censusTransform5x5(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& cen
     }
 }
 
+void censusTransform5x5Ref(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& censusMap,
+                           cv::Mat& censusMask) noexcept {
+    assert(src.type() == CV_8UC1 || src.type() == CV_16UC1);
+
+    if (src.depth() == CV_16U) {
+        censusTransform5x5RefImpl<uint16_t>(src, srcMask, censusMap, censusMask);
+    } else {
+        censusTransform5x5RefImpl<uint8_t>(src, srcMask, censusMap, censusMask);
+    }
+}
+
+void censusMask5x5(const cv::Mat& srcMask, cv::Mat& censusMask) noexcept {
+    assert(srcMask.type() == CV_8UC1);
+    assert(censusMask.type() == CV_32SC1);
+
+    for (const int row : rgs::views::iota(0, srcMask.rows)) {
+        uint32_t* pCsMask = censusMask.ptr<uint32_t>(row);
+        for (const int col : rgs::views::iota(0, srcMask.cols)) {
+            uint32_t bits = 0;
+            for (const int bitIdx : rgs::views::iota(0, CENSUS_BITS)) {
+                const int winRow = row + CENSUS_OFFSETS[bitIdx].first;
+                const int winCol = col + CENSUS_OFFSETS[bitIdx].second;
+                if (winRow < 0 || winRow >= srcMask.rows || winCol < 0 || winCol >= srcMask.cols) continue;
+                if (srcMask.at<uint8_t>(winRow, winCol) == 0) continue;
+                bits |= 1u << bitIdx;
+            }
+            pCsMask[col] = bits;
+        }
+    }
+}
+
+static constexpr int CENSUS_LANES = 16;  // int16 per AVX2 register
+
+// Columns of the signed 16bit copy with a border of `CENSUS_HALF_WINDOW`
+static inline int getPaddedCols(const int cols) noexcept {
+    return _hp::alignUp<CENSUS_LANES>(cols) + CENSUS_WINDOW - 1;
+}
+
+size_t censusMap5x5ScratchSize(const cv::Size size) noexcept {
+    return (size_t)(size.height + CENSUS_WINDOW - 1) * getPaddedCols(size.width);
+}
+
+template <typename TPix>
+static void censusMap5x5Impl(const cv::Mat& src, cv::Mat& censusMap, std::span<int16_t> padded) noexcept {
+    constexpr int LANES = CENSUS_LANES;
+
+    // Signed 16bit copy with a border of `CENSUS_HALF_WINDOW`, so the window loads need no bounds check.
+    // The border pixels are compared too, but their bits are cleared by the census mask.
+    // Flipping the sign bit keeps the order of unsigned 16bit samples under a signed compare.
+    const int paddedCols = getPaddedCols(src.cols);
+    assert(padded.size() >= censusMap5x5ScratchSize(src.size()));
+    std::fill_n(padded.begin(), censusMap5x5ScratchSize(src.size()), (int16_t)0);
+    for (const int row : rgs::views::iota(0, src.rows)) {
+        const TPix* psrc = src.ptr<TPix>(row);
+        int16_t* ppadded = padded.data() + (size_t)(row + CENSUS_HALF_WINDOW) * paddedCols + CENSUS_HALF_WINDOW;
+        for (const int col : rgs::views::iota(0, src.cols)) {
+            if constexpr (std::is_same_v<TPix, uint16_t>) {
+                ppadded[col] = (int16_t)(psrc[col] ^ 0x8000);
+            } else {
+                ppadded[col] = (int16_t)psrc[col];
+            }
+        }
+    }
+
+    std::array<int, CENSUS_BITS> loadOffsets;
+    rgs::transform(CENSUS_OFFSETS, loadOffsets.begin(),
+                   [paddedCols](const auto offset) { return offset.first * paddedCols + offset.second; });
+
+    for (const int row : rgs::views::iota(0, src.rows)) {
+        const int16_t* pcenters = padded.data() + (size_t)(row + CENSUS_HALF_WINDOW) * paddedCols + CENSUS_HALF_WINDOW;
+        uint32_t* pCsMap = censusMap.ptr<uint32_t>(row);
+        for (int col = 0; col < src.cols; col += LANES) {
+            const __m256i centers = _mm256_loadu_si256((const __m256i*)(pcenters + col));
+
+            // Bits 0-15 and 16-23 of 16 signatures
+            __m256i loBits = _mm256_setzero_si256();
+            __m256i hiBits = _mm256_setzero_si256();
+            for (const int bitIdx : rgs::views::iota(0, CENSUS_BITS)) {
+                const __m256i neighbors = _mm256_loadu_si256((const __m256i*)(pcenters + col + loadOffsets[bitIdx]));
+                const __m256i greater = _mm256_cmpgt_epi16(neighbors, centers);
+                const __m256i bit = _mm256_set1_epi16((int16_t)(1u << (bitIdx % 16)));
+                if (bitIdx < 16) {
+                    loBits = _mm256_or_si256(loBits, _mm256_and_si256(greater, bit));
+                } else {
+                    hiBits = _mm256_or_si256(hiBits, _mm256_and_si256(greater, bit));
+                }
+            }
+
+            // Interleave into 32bit signatures of pixels 0-7 and 8-15
+            const __m256i interleavedLo = _mm256_unpacklo_epi16(loBits, hiBits);
+            const __m256i interleavedHi = _mm256_unpackhi_epi16(loBits, hiBits);
+            const __m256i sigs0 = _mm256_permute2x128_si256(interleavedLo, interleavedHi, 0x20);
+            const __m256i sigs1 = _mm256_permute2x128_si256(interleavedLo, interleavedHi, 0x31);
+
+            uint32_t* pdst = pCsMap + col;
+            if (col + LANES <= src.cols) {
+                _mm256_storeu_si256((__m256i*)pdst, sigs0);
+                _mm256_storeu_si256((__m256i*)(pdst + LANES / 2), sigs1);
+            } else {
+                // Only the lanes before the end of the row are written
+                const int remaining = src.cols - col;
+                const __m256i laneIdx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+                const __m256i mask0 = _mm256_cmpgt_epi32(_mm256_set1_epi32(remaining), laneIdx);
+                const __m256i mask1 = _mm256_cmpgt_epi32(_mm256_set1_epi32(remaining - LANES / 2), laneIdx);
+                _mm256_maskstore_epi32((int*)pdst, mask0, sigs0);
+                _mm256_maskstore_epi32((int*)(pdst + LANES / 2), mask1, sigs1);
+            }
+        }
+    }
+}
+
+void censusMap5x5(const cv::Mat& src, cv::Mat& censusMap) {
+    std::vector<int16_t> padded(censusMap5x5ScratchSize(src.size()));
+    censusMap5x5(src, censusMap, padded);
+}
+
+void censusMap5x5(const cv::Mat& src, cv::Mat& censusMap, std::span<int16_t> padded) noexcept {
+    assert(src.type() == CV_8UC1 || src.type() == CV_16UC1);
+    assert(censusMap.type() == CV_32SC1);
+
+    if (src.depth() == CV_16U) {
+        censusMap5x5Impl<uint16_t>(src, censusMap, padded);
+    } else {
+        censusMap5x5Impl<uint8_t>(src, censusMap, padded);
+    }
+}
+
 }  // namespace tlct::_cvt::census
@@ -1,11 +1,34 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
 #include <opencv2/core.hpp>
 
+#include "tlct/helper/std.hpp"
+
 namespace tlct::_cvt::census {
 
-TLCT_API void censusTransform5x5(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& censusMap,
-                                 cv::Mat& censusMask) noexcept;
+// Bit `i` of the 24bit signature compares the `i`-th pixel of the 5x5 window (center excluded, row-major)
+// against the central one. `censusMap` and `censusMask` are `CV_32SC1` holding one packed signature per pixel.
+// The map bits are only meaningful where the mask bits are set.
+
+// Reference implementation, one pixel and one window pixel at a time.
+// `censusMask5x5` and `censusMap5x5` below give the same masked signatures.
+TLCT_API void censusTransform5x5Ref(const cv::Mat& src, const cv::Mat& srcMask, cv::Mat& censusMap,
+                                    cv::Mat& censusMask) noexcept;
+
+// Mask bits of the window pixels inside `srcMask` (`CV_8UC1`, non-zero for valid pixels) and inside the borders.
+// Only depends on `srcMask`, so it can be computed once for a fixed mask.
+TLCT_API void censusMask5x5(const cv::Mat& srcMask, cv::Mat& censusMask) noexcept;
+
+// Map bits of `src` (`CV_8UC1` or `CV_16UC1`), 16 pixels at once with AVX2.
+// Allocates its scratch buffer, so it may throw `std::bad_alloc`.
+TLCT_API void censusMap5x5(const cv::Mat& src, cv::Mat& censusMap);
+// Same as above without allocating, `padded` holds at least `censusMap5x5ScratchSize(src.size())` elements
+TLCT_API void censusMap5x5(const cv::Mat& src, cv::Mat& censusMap, std::span<int16_t> padded) noexcept;
+[[nodiscard]] TLCT_API size_t censusMap5x5ScratchSize(cv::Size size) noexcept;
 
 }  // namespace tlct::_cvt::census
 
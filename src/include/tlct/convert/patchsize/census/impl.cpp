@@ -1,6 +1,12 @@
+#include <cassert>
+#include <cstdint>
 #include <limits>
+#include <new>
 #include <queue>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -27,17 +33,75 @@ namespace rgs = std::ranges;
 
 template <cfg::concepts::CArrange TArrange>
 PsizeImpl_<TArrange>::PsizeImpl_(const TArrange& arrange, TMIBuffers&& mis, TMIBuffers&& prevMis,
-                                 TPInfos&& prevPatchInfos, const TPsizeParams& params) noexcept
+                                 TPInfos&& prevPatchInfos, CensusOverlaps&& overlaps,
+                                 std::vector<float>&& edgeCurves, std::vector<ESearch>&& searches,
+                                 const TPsizeParams& params) noexcept
     : arrange_(arrange),
       mis_(std::move(mis)),
       prevMis_(std::move(prevMis)),
       prevPatchInfos_(std::move(prevPatchInfos)),
+      overlaps_(std::move(overlaps)),
+      edgeCurves_(std::move(edgeCurves)),
+      searches_(std::move(searches)),
       params_(params) {}
 
 template <cfg::concepts::CArrange TArrange>
 template <concepts::CNeighbors TNeighbors>
-PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighbors,
-                                                        const MIBuffer& anchorMI) const noexcept {
+void PsizeImpl_<TArrange>::appendMatchOffsets(const TArrange& arrange, const TPsizeParams& params,
+                                              std::vector<cv::Point>& offsets) {
+    for (const auto direction : TNeighbors::DIRECTIONS) {
+        const cv::Point2f matchStep = -_hp::sgn(arrange.isKepler()) * TNeighbors::getUnitShift(direction);
+        for (const int psize : rgs::views::iota(params.minPsize, params.maxPsize)) {
+            const cv::Point2f cmpShift = matchStep * psize;
+            offsets.emplace_back(cmpShift);
+        }
+    }
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+int PsizeImpl_<TArrange>::getCurveIdx(const typename TNeighbors::Direction direction) noexcept {
+    // The near neighbors come first
+    return std::is_same_v<TNeighbors, NearNeighbors> ? (int)direction : NearNeighbors::DIRECTION_NUM + (int)direction;
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+size_t PsizeImpl_<TArrange>::getEdgeCurveOffset(const int miOffset,
+                                                const typename TNeighbors::Direction direction) const noexcept {
+    constexpr int OWNED_BEGIN = TNeighbors::DIRECTION_NUM / 2;
+    assert((int)direction >= OWNED_BEGIN);
+
+    // The near neighbors come first
+    const int slotIdx = (std::is_same_v<TNeighbors, NearNeighbors> ? 0 : NearNeighbors::DIRECTION_NUM / 2) +
+                        (int)direction - OWNED_BEGIN;
+    return ((size_t)miOffset * EDGE_SLOT_NUM + slotIdx) * overlaps_.getCurveLen();
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+std::span<const float> PsizeImpl_<TArrange>::getEdgeCurve(
+    const TNeighbors& neighbors, const typename TNeighbors::Direction direction) const noexcept {
+    const cv::Point selfIdx = neighbors.getSelfIdx();
+    const cv::Point neibIdx = neighbors.getNeighborIdx(direction);
+
+    size_t curveOffset;
+    if ((int)direction >= TNeighbors::DIRECTION_NUM / 2) {
+        curveOffset = getEdgeCurveOffset<TNeighbors>(selfIdx.y * arrange_.getMIMaxCols() + selfIdx.x, direction);
+    } else {
+        // Owned by the neighbor, which sees this MI in the opposite direction
+        assert(TNeighbors::fromArrangeAndIndex(arrange_, neibIdx).getNeighborIdx(
+                   TNeighbors::getOppositeDirection(direction)) == selfIdx);
+        curveOffset = getEdgeCurveOffset<TNeighbors>(neibIdx.y * arrange_.getMIMaxCols() + neibIdx.x,
+                                                     TNeighbors::getOppositeDirection(direction));
+    }
+
+    return std::span{edgeCurves_}.subspan(curveOffset, overlaps_.getCurveLen());
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighbors) const noexcept {
     float sumPsize = 0;
     float sumMetric = 0;
     float sumPsizeWeight = std::numeric_limits<float>::epsilon();
@@ -49,13 +113,14 @@ PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighb
         }
 
         const MIBuffer& neibMI = mis_.getMI(neighbors.getNeighborIdx(direction));
-        const cv::Point2f matchStep = -_hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction);
+
+        // Metric of every candidate psize, starting from `minPsize`
+        const std::span<const float> metrics = getEdgeCurve(neighbors, direction);
 
         int bestPsize = 0;
         float maxMetric = std::numeric_limits<float>::lowest();
         for (const int psize : rgs::views::iota(params_.minPsize, params_.maxPsize)) {
-            const cv::Point2f cmpShift = matchStep * psize;
-            const float metric = compare(anchorMI, neibMI, cmpShift);
+            const float metric = metrics[psize - params_.minPsize];
             if (metric > maxMetric) {
                 maxMetric = metric;
                 bestPsize = psize;
@@ -78,7 +143,7 @@ PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighb
 }
 
 template <cfg::concepts::CArrange TArrange>
-float PsizeImpl_<TArrange>::estimatePatchsize(TBridge& bridge, cv::Point index) const noexcept {
+auto PsizeImpl_<TArrange>::scheduleSearch(TBridge& bridge, cv::Point index) const noexcept -> ESearch {
     using PsizeParams = PsizeParams_<TArrange>;
 
     const int offset = index.y * arrange_.getMIMaxCols() + index.x;
@@ -103,22 +168,62 @@ float PsizeImpl_<TArrange>::estimatePatchsize(TBridge& bridge, cv::Point index)
         const float ssim = wrapAnchor.compare(wrapPrev);
         if (ssim >= params_.psizeShortcutThreshold) {
             bridge.getInfo(offset).setInherited(true);
-            return prevPsize;
+            bridge.getInfo(offset).setPatchsize(prevPsize);
+            return ESearch::eNone;
         }
     }
 
     const cfg::MITypes mitypes{arrange_.isOutShift()};
     const int miType = mitypes.getMIType(index);
 
-    float bestPsize;
     if (arrange_.isMultiFocus() && miType == arrange_.getNearFocalLenType()) {
         // if the MI type is for near focal, then only search its far neighbors
+        return ESearch::eFar;
+    }
+    return ESearch::eNear;
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+void PsizeImpl_<TArrange>::matchEdges(const ESearch search) noexcept {
+#pragma omp parallel for
+    for (int idx = 0; idx < (int)searches_.size(); idx++) {
+        const int row = idx / arrange_.getMIMaxCols();
+        const int col = idx % arrange_.getMIMaxCols();
+        if (col >= arrange_.getMICols(row)) {
+            continue;
+        }
+
+        const TNeighbors& neighbors = TNeighbors::fromArrangeAndIndex(arrange_, {col, row});
+        for (const auto direction : TNeighbors::DIRECTIONS | rgs::views::drop(TNeighbors::DIRECTION_NUM / 2)) {
+            if (!neighbors.hasNeighbor(direction)) [[unlikely]] {
+                continue;
+            }
+
+            const cv::Point neibIdx = neighbors.getNeighborIdx(direction);
+            const int neibOffset = neibIdx.y * arrange_.getMIMaxCols() + neibIdx.x;
+            if (searches_[idx] != search && searches_[neibOffset] != search) {
+                continue;
+            }
+
+            const std::span<float> curve = std::span{edgeCurves_}.subspan(
+                getEdgeCurveOffset<TNeighbors>(idx, direction), overlaps_.getCurveLen());
+            overlaps_.compareCurve(mis_.getMI(idx), mis_.getMI(neibOffset), getCurveIdx<TNeighbors>(direction),
+                                   curve);
+        }
+    }
+}
+
+template <cfg::concepts::CArrange TArrange>
+float PsizeImpl_<TArrange>::estimatePatchsize(cv::Point index, const ESearch search) const noexcept {
+    float bestPsize;
+    if (search == ESearch::eFar) {
         const FarNeighbors& farNeighbors = FarNeighbors::fromArrangeAndIndex(arrange_, index);
-        const PsizeMetric& farPsizeMetric = estimateWithNeighbors<FarNeighbors>(farNeighbors, anchorMI);
+        const PsizeMetric& farPsizeMetric = estimateWithNeighbors<FarNeighbors>(farNeighbors);
         bestPsize = farPsizeMetric.psize;
     } else {
         const NearNeighbors& nearNeighbors = NearNeighbors::fromArrangeAndIndex(arrange_, index);
-        const PsizeMetric& nearPsizeMetric = estimateWithNeighbors<NearNeighbors>(nearNeighbors, anchorMI);
+        const PsizeMetric& nearPsizeMetric = estimateWithNeighbors<NearNeighbors>(nearNeighbors);
         bestPsize = nearPsizeMetric.psize;
     }
 
@@ -298,11 +403,11 @@ void PsizeImpl_<TArrange>::adjustWgtsAndPsizesForMultiFocus(TBridge& bridge) noe
 template <cfg::concepts::CArrange TArrange>
 auto PsizeImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtCfg) noexcept
     -> std::expected<PsizeImpl_, Error> {
-    auto misRes = TMIBuffers::create(arrange);
+    auto misRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!misRes) return std::unexpected{std::move(misRes.error())};
     auto& mis = misRes.value();
 
-    auto prevMisRes = TMIBuffers::create(arrange);
+    auto prevMisRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!prevMisRes) return std::unexpected{std::move(prevMisRes.error())};
     auto& prevMis = prevMisRes.value();
 
@@ -312,7 +417,26 @@ auto PsizeImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvt
     if (!paramsRes) return std::unexpected{std::move(paramsRes.error())};
     auto& params = paramsRes.value();
 
-    return PsizeImpl_{arrange, std::move(mis), std::move(prevMis), std::move(prevPatchInfos), params};
+    // The census masks of all the candidate overlaps are composed once here
+    std::vector<cv::Point> matchOffsets;
+    std::vector<float> edgeCurves;
+    std::vector<ESearch> searches;
+    try {
+        appendMatchOffsets<NearNeighbors>(arrange, params, matchOffsets);
+        appendMatchOffsets<FarNeighbors>(arrange, params, matchOffsets);
+        edgeCurves.resize((size_t)prevPatchInfos.size() * EDGE_SLOT_NUM * (params.maxPsize - params.minPsize));
+        searches.resize(prevPatchInfos.size(), ESearch::eNone);
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    auto overlapsRes =
+        CensusOverlaps::create(mis.getCensusDiameter(), matchOffsets, params.maxPsize - params.minPsize);
+    if (!overlapsRes) return std::unexpected{std::move(overlapsRes.error())};
+    auto& overlaps = overlapsRes.value();
+
+    return PsizeImpl_{arrange,             std::move(mis),        std::move(prevMis),  std::move(prevPatchInfos),
+                      std::move(overlaps), std::move(edgeCurves), std::move(searches), params};
 }
 
 template <cfg::concepts::CArrange TArrange>
@@ -324,14 +448,30 @@ std::expected<void, Error> PsizeImpl_<TArrange>::updateBridge(const cv::Mat& src
     if (!updateRes) return std::unexpected{std::move(updateRes.error())};
 
 #pragma omp parallel for
-    for (int idx = 0; idx < (int)prevPatchInfos_.size(); idx++) {
+    for (int idx = 0; idx < (int)searches_.size(); idx++) {
         const int row = idx / arrange_.getMIMaxCols();
         const int col = idx % arrange_.getMIMaxCols();
         if (col >= arrange_.getMICols(row)) {
             continue;
         }
+        searches_[idx] = scheduleSearch(bridge, {col, row});
+    }
+
+    // Each edge is matched once and then read by both of its ends
+    matchEdges<NearNeighbors>(ESearch::eNear);
+    if (arrange_.isMultiFocus()) {
+        matchEdges<FarNeighbors>(ESearch::eFar);
+    }
+
+#pragma omp parallel for
+    for (int idx = 0; idx < (int)searches_.size(); idx++) {
+        const int row = idx / arrange_.getMIMaxCols();
+        const int col = idx % arrange_.getMIMaxCols();
+        if (col >= arrange_.getMICols(row) || searches_[idx] == ESearch::eNone) {
+            continue;
+        }
         const cv::Point index{col, row};
-        const float psize = estimatePatchsize(bridge, index);
+        const float psize = estimatePatchsize(index, searches_[idx]);
         bridge.getInfo(idx).setPatchsize(psize);
     }
 
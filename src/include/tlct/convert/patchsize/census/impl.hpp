@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include <opencv2/core.hpp>
@@ -46,21 +48,54 @@ private:
     using TPInfo = TBridge::TInfo;
     using TPInfos = TBridge::TInfos;
 
+    // Which neighbors an MI searches in the current frame
+    enum class ESearch : uint8_t {
+        eNone,  // inherits the previous psize
+        eNear,
+        eFar,
+    };
+
     PsizeImpl_(const TArrange& arrange, TMIBuffers&& mis, TMIBuffers&& prevMis, TPInfos&& prevPatchInfos,
+               CensusOverlaps&& overlaps, std::vector<float>&& edgeCurves, std::vector<ESearch>&& searches,
                const TPsizeParams& params) noexcept;
 
     using NearNeighbors = NearNeighbors_<TArrange>;
     using FarNeighbors = FarNeighbors_<TArrange>;
 
+    // Each MI owns the edges towards the second half of its neighbor directions
+    static constexpr int EDGE_SLOT_NUM = NearNeighbors::DIRECTION_NUM / 2 + FarNeighbors::DIRECTION_NUM / 2;
+
+    // Offsets of the neighbor MI content matched for each candidate psize, one curve per direction.
+    // The curves are in the order of `getCurveIdx`.
+    template <concepts::CNeighbors TNeighbors>
+    static void appendMatchOffsets(const TArrange& arrange, const TPsizeParams& params,
+                                   std::vector<cv::Point>& offsets);
+
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] static int getCurveIdx(typename TNeighbors::Direction direction) noexcept;
+
+    // Where the curve of the edge between MI `miOffset` and its neighbor in the owned `direction` starts
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] size_t getEdgeCurveOffset(int miOffset, typename TNeighbors::Direction direction) const noexcept;
+
+    // Metric of every candidate psize when matching the self MI of `neighbors` against its neighbor in `direction`.
+    // Matching an MI against its neighbor at a shift equals matching that neighbor against the MI at the opposite
+    // shift, so both ends of an edge read the same curve.
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] std::span<const float> getEdgeCurve(const TNeighbors& neighbors,
+                                                      typename TNeighbors::Direction direction) const noexcept;
+
+    // Inherits the previous psize when the MI barely changed, otherwise tells which neighbors to search
+    [[nodiscard]] ESearch scheduleSearch(TBridge& bridge, cv::Point index) const noexcept;
+
+    // Matches every edge with at least one end searching with `TNeighbors`, once per edge
     template <concepts::CNeighbors TNeighbors>
-    [[nodiscard]] float computePsizeMetric(const TNeighbors& neighbors, const MIBuffer& anchorMI,
-                                           float psize) const noexcept;
+    void matchEdges(ESearch search) noexcept;
 
     template <concepts::CNeighbors TNeighbors>
-    [[nodiscard]] PsizeMetric estimateWithNeighbors(const TNeighbors& neighbors,
-                                                    const MIBuffer& anchorMI) const noexcept;
+    [[nodiscard]] PsizeMetric estimateWithNeighbors(const TNeighbors& neighbors) const noexcept;
 
-    [[nodiscard]] float estimatePatchsize(TBridge& bridge, cv::Point index) const noexcept;
+    [[nodiscard]] float estimatePatchsize(cv::Point index, ESearch search) const noexcept;
 
     void adjustWgtsAndPsizesForMultiFocus(TBridge& bridge) noexcept;
 
@@ -86,6 +121,9 @@ private:
     TMIBuffers mis_;
     TMIBuffers prevMis_;
     TPInfos prevPatchInfos_;
+    CensusOverlaps overlaps_;
+    std::vector<float> edgeCurves_;
+    std::vector<ESearch> searches_;
     TPsizeParams params_;
 };
 
@@ -1,11 +1,18 @@
+#include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
+#include <cstdint>
 #include <format>
 #include <memory>
 #include <numbers>
+#include <numeric>
 #include <ranges>
+#include <span>
 #include <vector>
 
+#include <immintrin.h>
+#include <omp.h>
 #include <opencv2/imgproc.hpp>
 
 #include "tlct/config/arrange.hpp"
@@ -28,31 +35,47 @@ namespace rgs = std::ranges;
 
 template <cfg::concepts::CArrange TArrange>
 MIBuffers_<TArrange>::MIBuffers_(TArrange&& arrange, Params&& params, std::vector<MIBuffer>&& miBuffers,
-                                 std::unique_ptr<std::byte[]>&& pBuffer) noexcept
+                                 std::unique_ptr<std::byte[]>&& pBuffer, std::vector<int16_t>&& censusScratches,
+                                 std::vector<cv::Mat>&& centralYs) noexcept
     : arrange_(std::move(arrange)),
       params_(std::move(params)),
       miBuffers_(std::move(miBuffers)),
-      pBuffer_(std::move(pBuffer)) {}
+      pBuffer_(std::move(pBuffer)),
+      censusScratches_(std::move(censusScratches)),
+      centralYs_(std::move(centralYs)) {}
 
 template <cfg::concepts::CArrange TArrange>
-MIBuffers_<TArrange>::Params::Params(const TArrange& arrange) noexcept {
+MIBuffers_<TArrange>::Params::Params(const TArrange& arrange, int bitDepth) noexcept {
     censusDiameter_ = arrange.getDiameter() * CENSUS_SAFE_RATIO;
     const int iCensusDiameter = _hp::iround(censusDiameter_);
-    alignedMatSizeC3_ = _hp::alignUp<SIMD_FETCH_SIZE>(iCensusDiameter * iCensusDiameter * 3);
-    alignedMISize_ = alignedMatSizeC3_ * MIBuffer::C3_COUNT;
+    alignedMatSize_ = _hp::alignUp<SIMD_FETCH_SIZE>(iCensusDiameter * iCensusDiameter * sizeof(uint32_t));
+    const float censusRadius = censusDiameter_ / 2.f;
+    centralRoi_ = getRoiByCenter({censusRadius, censusRadius}, censusDiameter_ / std::numbers::sqrt2_v<float>);
+    censusScratchSize_ = censusMap5x5ScratchSize({iCensusDiameter, iCensusDiameter});
     miMaxCols_ = arrange.getMIMaxCols();
     miNum_ = miMaxCols_ * arrange.getMIRows();
-    bufferSize_ = miNum_ * alignedMISize_;
+    srcType_ = bitDepth > 8 ? CV_16UC1 : CV_8UC1;
+    threadNum_ = omp_get_max_threads();
+    bufferSize_ = miNum_ * alignedMatSize_;
+    pixScale_ = 255.f / (float)((1 << bitDepth) - 1);
 }
 
 template <cfg::concepts::CArrange TArrange>
-auto MIBuffers_<TArrange>::create(const TArrange& arrange) noexcept -> std::expected<MIBuffers_, Error> {
+auto MIBuffers_<TArrange>::create(const TArrange& arrange, int bitDepth) noexcept
+    -> std::expected<MIBuffers_, Error> {
     auto copiedArrange = arrange;
-    Params params{arrange};
+    Params params{arrange, bitDepth};
     try {
         std::vector<MIBuffer> miBuffers(params.miNum_);
         auto pBuffer = std::make_unique_for_overwrite<std::byte[]>(params.bufferSize_ + Params::SIMD_FETCH_SIZE);
-        return MIBuffers_{std::move(copiedArrange), std::move(params), std::move(miBuffers), std::move(pBuffer)};
+        std::vector<int16_t> censusScratches(params.censusScratchSize_ * params.threadNum_);
+        std::vector<cv::Mat> centralYs;
+        centralYs.reserve(params.threadNum_);
+        for ([[maybe_unused]] const int threadIdx : rgs::views::iota(0, params.threadNum_)) {
+            centralYs.emplace_back(params.centralRoi_.size(), params.srcType_);
+        }
+        return MIBuffers_{std::move(copiedArrange), std::move(params),           std::move(miBuffers),
+                          std::move(pBuffer),       std::move(censusScratches), std::move(centralYs)};
     } catch (const std::bad_alloc&) {
         return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
     }
@@ -60,113 +83,236 @@ auto MIBuffers_<TArrange>::create(const TArrange& arrange) noexcept -> std::expe
 
 template <cfg::concepts::CArrange TArrange>
 std::expected<void, Error> MIBuffers_<TArrange>::update(const cv::Mat& src) noexcept {
-    // TODO: handle `std::bad_alloc` in this func
-    if (src.type() != CV_8UC1) [[unlikely]] {
-        auto errMsg = std::format("MIBuffers::update expect CV_8UC1, got {}", src.type());
+    if (src.type() != params_.srcType_) [[unlikely]] {
+        auto errMsg = std::format("MIBuffers::update expect type {}, got {}", params_.srcType_, src.type());
         return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
     }
 
     const int iCensusDiameter = _hp::iround(params_.censusDiameter_);
-    const float censusRadius = params_.censusDiameter_ / 2.f;
-    const int iCensusRadius = _hp::iround(params_.censusDiameter_ / 2.f);
-    const cv::Mat srcCircleMask = cv::Mat::zeros(iCensusDiameter, iCensusDiameter, CV_8UC1);
-    cv::circle(srcCircleMask, {iCensusRadius, iCensusRadius}, iCensusRadius, cv::Scalar::all(0xff), cv::FILLED);
-
-    const cv::Rect centralRoi =
-        getRoiByCenter({censusRadius, censusRadius}, params_.censusDiameter_ / std::numbers::sqrt2_v<float>);
 
     uint8_t* bufBase = (uint8_t*)_hp::alignUp<Params::SIMD_FETCH_SIZE>((size_t)pBuffer_.get());
-#pragma omp parallel for
-    for (int idx = 0; idx < params_.miNum_; idx++) {
-        const int rowMIIdx = idx / params_.miMaxCols_;
-        const int colMIIdx = idx % params_.miMaxCols_;
-        if (colMIIdx >= arrange_.getMICols(rowMIIdx)) {
-            continue;
-        }
-
-        auto miBufIterator = miBuffers_.begin() + idx;
-        cv::Mat tmpI = cv::Mat(iCensusDiameter, iCensusDiameter, CV_8UC1);
+#pragma omp parallel
+    {
+        // Reused by all the MIs of this thread
+        const int threadIdx = omp_get_thread_num();
+        const std::span<int16_t> censusScratch =
+            std::span{censusScratches_}.subspan(threadIdx * params_.censusScratchSize_, params_.censusScratchSize_);
+        cv::Mat& centralY = centralYs_[threadIdx];
 
-        const cv::Point2f& miCenter = arrange_.getMICenter(rowMIIdx, colMIIdx);
-        const cv::Rect miRoi = getRoiByCenter(miCenter, params_.censusDiameter_);
-
-        uint8_t* matBufCursor = bufBase + idx * params_.alignedMISize_;
+#pragma omp for
+        for (int idx = 0; idx < params_.miNum_; idx++) {
+            const int rowMIIdx = idx / params_.miMaxCols_;
+            const int colMIIdx = idx % params_.miMaxCols_;
+            if (colMIIdx >= arrange_.getMICols(rowMIIdx)) {
+                continue;
+            }
 
-        const cv::Mat& srcI = src(miRoi);
-        srcI.copyTo(tmpI);
-        cv::Mat centralY = tmpI(centralRoi);
+            auto miBufIterator = miBuffers_.begin() + idx;
 
-        cv::Mat censusMap = cv::Mat(iCensusDiameter, iCensusDiameter, CV_8UC3, matBufCursor);
-        matBufCursor += params_.alignedMatSizeC3_;
-        cv::Mat censusMask = cv::Mat(iCensusDiameter, iCensusDiameter, CV_8UC3, matBufCursor);
-        censusTransform5x5(tmpI, srcCircleMask, censusMap, censusMask);
+            const cv::Point2f& miCenter = arrange_.getMICenter(rowMIIdx, colMIIdx);
+            const cv::Rect miRoi = getRoiByCenter(miCenter, params_.censusDiameter_);
+            const cv::Mat& srcI = src(miRoi);
 
-        miBufIterator->censusMap = std::move(censusMap);
-        miBufIterator->censusMask = std::move(censusMask);
+            // The census transform never reads past `srcI`
+            cv::Mat censusMap = cv::Mat(iCensusDiameter, iCensusDiameter, CV_32SC1,
+                                        bufBase + idx * params_.alignedMatSize_);
+            censusMap5x5(srcI, censusMap, censusScratch);
+            miBufIterator->censusMap = std::move(censusMap);
 
-        const float grads = computeGrads(centralY);
-        miBufIterator->grads = grads;
+            // `Sobel` samples the pixels around a ROI as its border, so the central part is copied first
+            srcI(params_.centralRoi_).copyTo(centralY);
+            const float grads = computeGrads(centralY) * params_.pixScale_;
+            miBufIterator->grads = grads;
+        }
     }
 
     return {};
 }
 
-[[nodiscard]] float compare(const MIBuffer& lhsMI, const MIBuffer& rhsMI, cv::Point2f offset) noexcept {
-    assert(lhsMI.censusMap.size() == rhsMI.censusMap.size());
+// Bit counts of the 4 64bit lanes, with the nibble lookup of Mula et al.
+static inline __m256i popcount64x4(const __m256i v) noexcept {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbleMask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, lowNibbleMask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbleMask);
+    const __m256i byteCounts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(byteCounts, _mm256_setzero_si256());
+}
 
-    const std::array ranges{cv::Range{0, lhsMI.censusMap.rows}, cv::Range{0, lhsMI.censusMap.cols}};
+static inline uint64_t hsum64x4(const __m256i v) noexcept {
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return (uint64_t)_mm_cvtsi128_si64(sum) + (uint64_t)_mm_extract_epi64(sum, 1);
+}
 
-    const auto applyOffset = [&ranges](cv::Point offset) {
-        auto [rowRange, colRange] = ranges;
-        if (offset.y > 0) {
-            rowRange.start += offset.y;
-        } else {
-            rowRange.end += offset.y;
-        }
-        if (offset.x > 0) {
-            colRange.start += offset.x;
-        } else {
-            colRange.end += offset.x;
+// {rows, cols} of a `size` census map seen by an MI whose content is shifted by `offset`
+static inline std::array<cv::Range, 2> getOverlapRanges(const cv::Size size, const cv::Point offset) noexcept {
+    cv::Range rowRange{0, size.height};
+    cv::Range colRange{0, size.width};
+    if (offset.y > 0) {
+        rowRange.start += offset.y;
+    } else {
+        rowRange.end += offset.y;
+    }
+    if (offset.x > 0) {
+        colRange.start += offset.x;
+    } else {
+        colRange.end += offset.x;
+    }
+    return {rowRange, colRange};
+}
+
+CensusOverlaps::CensusOverlaps(std::vector<CensusOverlap>&& overlaps, const int curveLen,
+                               std::vector<std::vector<int>>&& dyGroups, std::vector<int>&& groupBegins) noexcept
+    : overlaps_(std::move(overlaps)),
+      curveLen_(curveLen),
+      dyGroups_(std::move(dyGroups)),
+      groupBegins_(std::move(groupBegins)) {}
+
+auto CensusOverlaps::create(const float censusDiameter, std::span<const cv::Point> offsets, const int curveLen) noexcept
+    -> std::expected<CensusOverlaps, Error> {
+    try {
+        const int iCensusDiameter = _hp::iround(censusDiameter);
+        const int iCensusRadius = _hp::iround(censusDiameter / 2.f);
+        const cv::Mat srcCircleMask = cv::Mat::zeros(iCensusDiameter, iCensusDiameter, CV_8UC1);
+        cv::circle(srcCircleMask, {iCensusRadius, iCensusRadius}, iCensusRadius, cv::Scalar::all(0xff), cv::FILLED);
+
+        cv::Mat censusMask{iCensusDiameter, iCensusDiameter, CV_32SC1};
+        censusMask5x5(srcCircleMask, censusMask);
+
+        std::vector<CensusOverlap> overlaps;
+        overlaps.reserve(offsets.size());
+        for (const cv::Point offset : offsets) {
+            const auto lhsRanges = getOverlapRanges(censusMask.size(), -offset);
+            const auto rhsRanges = getOverlapRanges(censusMask.size(), offset);
+
+            cv::Mat mask;
+            cv::bitwise_and(censusMask(lhsRanges.data()), censusMask(rhsRanges.data()), mask);
+
+            uint64_t maskBitCount = 0;
+            for (const int row : rgs::views::iota(0, mask.rows)) {
+                const uint32_t* pMask = mask.ptr<uint32_t>(row);
+                for (const int col : rgs::views::iota(0, mask.cols)) {
+                    maskBitCount += std::popcount(pMask[col]);
+                }
+            }
+
+            overlaps.push_back({offset, lhsRanges, rhsRanges, std::move(mask), maskBitCount});
         }
-        return std::array{rowRange, colRange};
-    };
 
-    const auto lhsRanges = applyOffset(-offset);
-    const auto rhsRanges = applyOffset(offset);
-
-    const auto& lhsCensusMap = lhsMI.censusMap(lhsRanges.data());
-    const auto& lhsCensusMask = lhsMI.censusMask(lhsRanges.data());
-
-    const auto& rhsCensusMap = rhsMI.censusMap(rhsRanges.data());
-    const auto& rhsCensusMask = rhsMI.censusMask(rhsRanges.data());
-
-    uint64_t maskBitCount = 0;
-    uint64_t diffBitCount = 0;
-    for (const int row : rgs::views::iota(0, lhsRanges[0].size())) {
-        const cv::Vec3b* pLhsMap = lhsCensusMap.ptr<cv::Vec3b>(row);
-        const cv::Vec3b* pLhsMask = lhsCensusMask.ptr<cv::Vec3b>(row);
-        const cv::Vec3b* pRhsMap = rhsCensusMap.ptr<cv::Vec3b>(row);
-        const cv::Vec3b* pRhsMask = rhsCensusMask.ptr<cv::Vec3b>(row);
-        for ([[maybe_unused]] const int _ : rgs::views::iota(0, lhsRanges[1].size())) {
-            constexpr int BYTE_COUNT = 3;
-            for (const int byteId : rgs::views::iota(0, BYTE_COUNT)) {
-                const uint8_t diff = (*pLhsMap)[byteId] ^ (*pRhsMap)[byteId];
-                const uint8_t mask = (*pLhsMask)[byteId] & (*pRhsMask)[byteId];
-                const uint8_t maskedDiff = mask & diff;
-                maskBitCount += std::popcount(mask);
-                diffBitCount += std::popcount(maskedDiff);
+        const int curveCount = curveLen > 0 ? (int)offsets.size() / curveLen : 0;
+        std::vector<std::vector<int>> dyGroups;
+        std::vector<int> groupBegins{0};
+        for (const int curveIdx : rgs::views::iota(0, curveCount)) {
+            std::vector<int> curveIndices(curveLen);
+            std::iota(curveIndices.begin(), curveIndices.end(), curveIdx * curveLen);
+            rgs::stable_sort(curveIndices, {}, [&offsets](const int idx) { return offsets[idx].y; });
+
+            auto groupBegin = curveIndices.begin();
+            while (groupBegin != curveIndices.end()) {
+                const int dy = offsets[*groupBegin].y;
+                const auto groupEnd =
+                    std::find_if(groupBegin, curveIndices.end(), [&](const int idx) { return offsets[idx].y != dy; });
+                dyGroups.emplace_back(groupBegin, groupEnd);
+                groupBegin = groupEnd;
             }
-            pLhsMap++;
-            pLhsMask++;
-            pRhsMap++;
-            pRhsMask++;
+            groupBegins.push_back((int)dyGroups.size());
         }
+
+        return CensusOverlaps{std::move(overlaps), curveLen, std::move(dyGroups), std::move(groupBegins)};
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+}
+
+// Masked Hamming distance of one row pair, as 4 partial sums
+static inline __m256i rowDiffBits(const int* pLhsMap, const int* pRhsMap, const int* pMask, const int rowLen) noexcept {
+    constexpr int LANES = 8;
+
+    __m256i diffBitCounts = _mm256_setzero_si256();
+    const auto accumulate = [&](const __m256i lhsMap, const __m256i rhsMap, const __m256i mask) {
+        const __m256i maskedDiff = _mm256_and_si256(mask, _mm256_xor_si256(lhsMap, rhsMap));
+        diffBitCounts = _mm256_add_epi64(diffBitCounts, popcount64x4(maskedDiff));
+    };
+
+    // 8 signatures per step, the tail lanes are masked out of the loads
+    int col = 0;
+    for (; col + LANES <= rowLen; col += LANES) {
+        accumulate(_mm256_loadu_si256((const __m256i*)(pLhsMap + col)),
+                   _mm256_loadu_si256((const __m256i*)(pRhsMap + col)),
+                   _mm256_loadu_si256((const __m256i*)(pMask + col)));
+    }
+    if (col < rowLen) {
+        const __m256i laneIdx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i tailMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(rowLen - col), laneIdx);
+        accumulate(_mm256_maskload_epi32(pLhsMap + col, tailMask), _mm256_maskload_epi32(pRhsMap + col, tailMask),
+                   _mm256_maskload_epi32(pMask + col, tailMask));
+    }
+
+    return diffBitCounts;
+}
+
+[[nodiscard]] float compare(const MIBuffer& lhsMI, const MIBuffer& rhsMI, const CensusOverlap& overlap) noexcept {
+    assert(lhsMI.censusMap.size() == rhsMI.censusMap.size());
+
+    const cv::Mat& lhsCensusMap = lhsMI.censusMap(overlap.lhsRanges.data());
+    const cv::Mat& rhsCensusMap = rhsMI.censusMap(overlap.rhsRanges.data());
+
+    __m256i diffBitCounts = _mm256_setzero_si256();
+    for (const int row : rgs::views::iota(0, overlap.mask.rows)) {
+        const __m256i rowDiff = rowDiffBits(lhsCensusMap.ptr<int>(row), rhsCensusMap.ptr<int>(row),
+                                            overlap.mask.ptr<int>(row), overlap.mask.cols);
+        diffBitCounts = _mm256_add_epi64(diffBitCounts, rowDiff);
     }
 
-    const float diffRatio = (float)diffBitCount / (float)maskBitCount;
+    const uint64_t diffBitCount = hsum64x4(diffBitCounts);
+
+    const float diffRatio = (float)diffBitCount / (float)overlap.maskBitCount;
     return 1.f - diffRatio;
 }
 
+void CensusOverlaps::compareCurve(const MIBuffer& lhsMI, const MIBuffer& rhsMI, const int curveIdx,
+                                  std::span<float> metrics) const noexcept {
+    assert(lhsMI.censusMap.size() == rhsMI.censusMap.size());
+    assert((int)metrics.size() >= curveLen_);
+
+    // Accumulators of the offsets evaluated together
+    constexpr int CHUNK = 8;
+
+    for (const int groupIdx : rgs::views::iota(groupBegins_[curveIdx], groupBegins_[curveIdx + 1])) {
+        const std::vector<int>& group = dyGroups_[groupIdx];
+        const CensusOverlap& head = overlaps_[group.front()];
+        const int lhsRowBegin = head.lhsRanges[0].start;
+        const int rhsRowBegin = head.rhsRanges[0].start;
+
+        for (size_t chunkBegin = 0; chunkBegin < group.size(); chunkBegin += CHUNK) {
+            const int chunkSize = (int)std::min<size_t>(CHUNK, group.size() - chunkBegin);
+            std::array<__m256i, CHUNK> diffBitCounts;
+            diffBitCounts.fill(_mm256_setzero_si256());
+
+            // Both rows stay in cache while every offset of the chunk scans them
+            for (const int row : rgs::views::iota(0, head.mask.rows)) {
+                const int* pLhsRow = lhsMI.censusMap.ptr<int>(lhsRowBegin + row);
+                const int* pRhsRow = rhsMI.censusMap.ptr<int>(rhsRowBegin + row);
+                for (const int i : rgs::views::iota(0, chunkSize)) {
+                    const CensusOverlap& overlap = overlaps_[group[chunkBegin + i]];
+                    const __m256i rowDiff = rowDiffBits(pLhsRow + overlap.lhsRanges[1].start,
+                                                        pRhsRow + overlap.rhsRanges[1].start,
+                                                        overlap.mask.ptr<int>(row), overlap.mask.cols);
+                    diffBitCounts[i] = _mm256_add_epi64(diffBitCounts[i], rowDiff);
+                }
+            }
+
+            for (const int i : rgs::views::iota(0, chunkSize)) {
+                const int overlapIdx = group[chunkBegin + i];
+                const float diffRatio =
+                    (float)hsum64x4(diffBitCounts[i]) / (float)overlaps_[overlapIdx].maskBitCount;
+                metrics[overlapIdx - curveIdx * curveLen_] = 1.f - diffRatio;
+            }
+        }
+    }
+}
+
 template class MIBuffers_<cfg::CornersArrange>;
 template class MIBuffers_<cfg::OffsetArrange>;
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <opencv2/core.hpp>
@@ -12,13 +15,57 @@
 namespace tlct::_cvt::census {
 
 struct MIBuffer {
-    static constexpr int C3_COUNT = 2;
-    cv::Mat censusMap;   // 8UC3
-    cv::Mat censusMask;  // 8UC3
+    cv::Mat censusMap;  // 32SC1, one packed census signature per pixel
 
     float grads;
 };
 
+// The census mask only depends on the circle mask and the borders of the census window, so it is the same for
+// every MI. The mask of the overlap between two MIs then only depends on their offset.
+struct CensusOverlap {
+    cv::Point offset;  // of the rhs MI content relative to the lhs one
+    std::array<cv::Range, 2> lhsRanges;
+    std::array<cv::Range, 2> rhsRanges;
+    cv::Mat mask;  // 32SC1, the census masks of both MIs ANDed over the overlap
+    uint64_t maskBitCount;
+};
+
+class CensusOverlaps {
+    CensusOverlaps(std::vector<CensusOverlap>&& overlaps, int curveLen, std::vector<std::vector<int>>&& dyGroups,
+                   std::vector<int>&& groupBegins) noexcept;
+
+public:
+    // Constructor
+    CensusOverlaps() = delete;
+    CensusOverlaps(const CensusOverlaps& rhs) = delete;
+    CensusOverlaps& operator=(const CensusOverlaps& rhs) = delete;
+    CensusOverlaps(CensusOverlaps&& rhs) noexcept = default;
+    CensusOverlaps& operator=(CensusOverlaps&& rhs) noexcept = default;
+
+    // Initialize from
+    // Composes the overlap of each of `offsets` once, `get(i)` is the one of `offsets[i]`.
+    // Every `curveLen` consecutive offsets form the cost curve of one match direction.
+    [[nodiscard]] TLCT_API static std::expected<CensusOverlaps, Error> create(float censusDiameter,
+                                                                              std::span<const cv::Point> offsets,
+                                                                              int curveLen) noexcept;
+
+    // Const methods
+    [[nodiscard]] const CensusOverlap& get(const int idx) const noexcept { return overlaps_[idx]; }
+    [[nodiscard]] int getCurveLen() const noexcept { return curveLen_; }
+
+    // `metrics[i]` equals `compare(lhsMI, rhsMI, get(curveIdx * getCurveLen() + i))`.
+    // The offsets sharing a vertical shift pair the same rows, so they are evaluated together row pair by row pair.
+    TLCT_API void compareCurve(const MIBuffer& lhsMI, const MIBuffer& rhsMI, int curveIdx,
+                               std::span<float> metrics) const noexcept;
+
+private:
+    std::vector<CensusOverlap> overlaps_;
+    int curveLen_;
+    // Overlap indices grouped by vertical shift, the groups of curve `i` are [groupBegins_[i], groupBegins_[i + 1])
+    std::vector<std::vector<int>> dyGroups_;
+    std::vector<int> groupBegins_;
+};
+
 template <cfg::concepts::CArrange TArrange_>
 class MIBuffers_ {
 public:
@@ -26,24 +73,29 @@ public:
     using TArrange = TArrange_;
 
     struct Params {
-        static constexpr size_t SIMD_FETCH_SIZE = 128 / 8;
+        static constexpr size_t SIMD_FETCH_SIZE = 256 / 8;
 
         Params() = default;
-        Params(const TArrange& arrange) noexcept;
+        Params(const TArrange& arrange, int bitDepth) noexcept;
         Params& operator=(Params&& rhs) noexcept = default;
         Params(Params&& rhs) noexcept = default;
 
-        size_t alignedMatSizeC3_;
-        size_t alignedMISize_;
+        size_t alignedMatSize_;
         size_t bufferSize_;
         float censusDiameter_;
+        cv::Rect centralRoi_;  // of the census window, where the gradients are measured
+        size_t censusScratchSize_;
         int miMaxCols_;
         int miNum_;
+        int srcType_;
+        int threadNum_;
+        float pixScale_;  // maps samples of `bitDepth` onto the 8bit range
     };
 
 private:
     MIBuffers_(TArrange&& arrange, Params&& params, std::vector<MIBuffer>&& miBuffers,
-               std::unique_ptr<std::byte[]>&& pBuffer) noexcept;
+               std::unique_ptr<std::byte[]>&& pBuffer, std::vector<int16_t>&& censusScratches,
+               std::vector<cv::Mat>&& centralYs) noexcept;
 
 public:
     // Constructor
@@ -54,7 +106,8 @@ public:
     MIBuffers_(MIBuffers_&& rhs) noexcept = default;
 
     // Initialize from
-    [[nodiscard]] TLCT_API static std::expected<MIBuffers_, Error> create(const TArrange& arrange) noexcept;
+    [[nodiscard]] TLCT_API static std::expected<MIBuffers_, Error> create(const TArrange& arrange,
+                                                                          int bitDepth) noexcept;
 
     // Const methods
     [[nodiscard]] const MIBuffer& getMI(const int offset) const noexcept { return miBuffers_.at(offset); }
@@ -63,6 +116,7 @@ public:
         return getMI(offset);
     }
     [[nodiscard]] const MIBuffer& getMI(const cv::Point index) const noexcept { return getMI(index.y, index.x); }
+    [[nodiscard]] float getCensusDiameter() const noexcept { return params_.censusDiameter_; }
 
     // Non-const methods
     [[nodiscard]] TLCT_API std::expected<void, Error> update(const cv::Mat& src) noexcept;
@@ -72,9 +126,14 @@ private:
     Params params_;
     std::vector<MIBuffer> miBuffers_;
     std::unique_ptr<std::byte[]> pBuffer_;
+    // Per-thread scratch of `update`, allocated once so the parallel region never allocates
+    std::vector<int16_t> censusScratches_;
+    std::vector<cv::Mat> centralYs_;
 };
 
-[[nodiscard]] TLCT_API float compare(const MIBuffer& lhsMI, const MIBuffer& rhsMI, cv::Point2f offset) noexcept;
+// One offset at a time, the reference `CensusOverlaps::compareCurve` is tested against
+[[nodiscard]] TLCT_API float compare(const MIBuffer& lhsMI, const MIBuffer& rhsMI,
+                                     const CensusOverlap& overlap) noexcept;
 
 }  // namespace tlct::_cvt::census
 
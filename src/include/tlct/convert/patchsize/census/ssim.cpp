@@ -11,7 +11,11 @@ namespace tlct::_cvt::census {
 inline void blurInto(const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, {11, 11}, 1.5); }
 
 void WrapSSIM::updateRoi(cv::Rect roi) noexcept {
-    mi_.censusMap(roi).copyTo(I_);  // `BORDER_ISOLATED` has no effect, so we must copy here
+    // Only the lowest byte of the packed signatures, the first channel of the former `CV_8UC3` maps.
+    // `compare` only ever reported the SSIM of that channel.
+    const cv::Mat censusMap = mi_.censusMap(roi);
+    const cv::Mat censusBytes{censusMap.rows, censusMap.cols, CV_8UC4, censusMap.data, censusMap.step};
+    cv::extractChannel(censusBytes, I_, 0);  // `BORDER_ISOLATED` has no effect, so we must copy here
     cv::multiply(I_, I_, I2_);
     blurInto(I_, mu_);
     cv::multiply(mu_, mu_, mu2_);
@@ -319,11 +319,11 @@ void PsizeImpl_<TArrange>::adjustWgtsAndPsizesForMultiFocus(TBridge& bridge) noe
 template <cfg::concepts::CArrange TArrange>
 auto PsizeImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtCfg) noexcept
     -> std::expected<PsizeImpl_, Error> {
-    auto misRes = TMIBuffers::create(arrange);
+    auto misRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!misRes) return std::unexpected{std::move(misRes.error())};
     auto& mis = misRes.value();
 
-    auto prevMisRes = TMIBuffers::create(arrange);
+    auto prevMisRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!prevMisRes) return std::unexpected{std::move(prevMisRes.error())};
     auto& prevMis = prevMisRes.value();
 
@@ -77,6 +77,10 @@ public:
         const auto& unitShift = UNIT_SHIFTS[(int)direction];
         return {unitShift[0], unitShift[1]};
     }
+    // The directions are listed point-symmetrically, so the second half are the opposites of the first half
+    [[nodiscard]] TLCT_API static Direction getOppositeDirection(const Direction direction) noexcept {
+        return (Direction)(DIRECTION_NUM - 1 - (int)direction);
+    }
 
 private:
     TIndices indices_;
@@ -161,6 +165,10 @@ public:
         const auto& unitShift = UNIT_SHIFTS[(int)direction];
         return {unitShift[0], unitShift[1]};
     }
+    // The directions are listed point-symmetrically, so the second half are the opposites of the first half
+    [[nodiscard]] TLCT_API static Direction getOppositeDirection(const Direction direction) noexcept {
+        return (Direction)(DIRECTION_NUM - 1 - (int)direction);
+    }
 
 private:
     TIndices indices_;
@@ -1,6 +1,13 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <format>
 #include <limits>
+#include <new>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -25,19 +32,141 @@ namespace rgs = std::ranges;
 
 template <cfg::concepts::CArrange TArrange>
 PsizeImpl_<TArrange>::PsizeImpl_(const TArrange& arrange, TMIBuffers&& mis, TMIBuffers&& prevMis,
-                                 TPInfos&& prevPatchInfos, const TPsizeParams& params) noexcept
+                                 TPInfos&& prevPatchInfos, std::vector<float>&& edgeCurves,
+                                 std::vector<uint8_t>&& searchings, const int curveLen,
+                                 const TPsizeParams& params) noexcept
     : arrange_(arrange),
       mis_(std::move(mis)),
       prevMis_(std::move(prevMis)),
       prevPatchInfos_(std::move(prevPatchInfos)),
+      edgeCurves_(std::move(edgeCurves)),
+      searchings_(std::move(searchings)),
+      curveLen_(curveLen),
       params_(params) {}
 
 template <cfg::concepts::CArrange TArrange>
 template <concepts::CNeighbors TNeighbors>
-PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighbors,
-                                                        WrapSSIM& wrapAnchor) const noexcept {
+cv::Rect PsizeImpl_<TArrange>::getAnchorRoi(const typename TNeighbors::Direction direction) const noexcept {
     const cv::Point2f miCenter{arrange_.getRadius(), arrange_.getRadius()};
-    const int maxShift = (int)(params_.patternShift * 2);
+    const cv::Point2f anchorShift =
+        _hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction) * params_.patternShift;
+    return getRoiByCenter(miCenter + anchorShift, params_.patternSize);
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+size_t PsizeImpl_<TArrange>::getEdgeCurveOffset(const int miOffset,
+                                                const typename TNeighbors::Direction direction) const noexcept {
+    constexpr int OWNED_BEGIN = TNeighbors::DIRECTION_NUM / 2;
+    assert((int)direction >= OWNED_BEGIN);
+
+    // The near neighbors come first
+    const int slotIdx = (std::is_same_v<TNeighbors, NearNeighbors> ? 0 : NearNeighbors::DIRECTION_NUM / 2) +
+                        (int)direction - OWNED_BEGIN;
+    return ((size_t)miOffset * EDGE_SLOT_NUM + slotIdx) * curveLen_;
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+std::span<const float> PsizeImpl_<TArrange>::getEdgeCurve(
+    const TNeighbors& neighbors, const typename TNeighbors::Direction direction) const noexcept {
+    const cv::Point selfIdx = neighbors.getSelfIdx();
+    const cv::Point neibIdx = neighbors.getNeighborIdx(direction);
+
+    size_t curveOffset;
+    if ((int)direction >= TNeighbors::DIRECTION_NUM / 2) {
+        curveOffset = getEdgeCurveOffset<TNeighbors>(selfIdx.y * arrange_.getMIMaxCols() + selfIdx.x, direction);
+    } else {
+        // Owned by the neighbor, which sees this MI in the opposite direction
+        assert(TNeighbors::fromArrangeAndIndex(arrange_, neibIdx).getNeighborIdx(
+                   TNeighbors::getOppositeDirection(direction)) == selfIdx);
+        curveOffset = getEdgeCurveOffset<TNeighbors>(neibIdx.y * arrange_.getMIMaxCols() + neibIdx.x,
+                                                     TNeighbors::getOppositeDirection(direction));
+    }
+
+    return std::span{edgeCurves_}.subspan(curveOffset, curveLen_);
+}
+
+template <cfg::concepts::CArrange TArrange>
+bool PsizeImpl_<TArrange>::scheduleSearch(TBridge& bridge, cv::Point index) const noexcept {
+    using PsizeParams = PsizeParams_<TArrange>;
+
+    const int offset = index.y * arrange_.getMIMaxCols() + index.x;
+    const float prevPsize = getPrevPatchsize(offset);
+
+    if (prevPsize != PsizeParams::INVALID_PSIZE) [[likely]] {
+        const cv::Point2f miCenter{arrange_.getRadius(), arrange_.getRadius()};
+        const cv::Rect roi = getRoiByCenter(miCenter, arrange_.getDiameter() / std::numbers::sqrt2_v<float>);
+
+        WrapSSIM wrapAnchor{mis_.getMI(offset)};
+        wrapAnchor.updateRoi(roi);
+        WrapSSIM wrapPrev{prevMis_.getMI(offset)};
+        wrapPrev.updateRoi(roi);
+
+        const float ssim = wrapAnchor.compare(wrapPrev);
+        if (ssim >= params_.psizeShortcutThreshold) {
+            bridge.getInfo(offset).setInherited(true);
+            bridge.getInfo(offset).setPatchsize(prevPsize);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+void PsizeImpl_<TArrange>::matchEdges() noexcept {
+    const cv::Point2f miCenter{arrange_.getRadius(), arrange_.getRadius()};
+
+#pragma omp parallel for
+    for (int idx = 0; idx < (int)searchings_.size(); idx++) {
+        const int row = idx / arrange_.getMIMaxCols();
+        const int col = idx % arrange_.getMIMaxCols();
+        if (col >= arrange_.getMICols(row)) {
+            continue;
+        }
+
+        const TNeighbors& neighbors = TNeighbors::fromArrangeAndIndex(arrange_, {col, row});
+        WrapSSIM wrapAnchor{mis_.getMI(idx)};
+        for (const auto direction : TNeighbors::DIRECTIONS | rgs::views::drop(TNeighbors::DIRECTION_NUM / 2)) {
+            if (!neighbors.hasNeighbor(direction)) [[unlikely]] {
+                continue;
+            }
+
+            const cv::Point neibIdx = neighbors.getNeighborIdx(direction);
+            const int neibOffset = neibIdx.y * arrange_.getMIMaxCols() + neibIdx.x;
+            if (!searchings_[idx] && !searchings_[neibOffset]) {
+                continue;
+            }
+
+            wrapAnchor.updateRoi(getAnchorRoi<TNeighbors>(direction));
+            WrapSSIM wrapNeib{mis_.getMI(neibOffset)};
+
+            const cv::Point2f anchorShift =
+                _hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction) * params_.patternShift;
+            const cv::Point2f matchStep = -_hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction);
+            cv::Point2f cmpShift = anchorShift + matchStep * params_.minPsize;
+
+            const std::span<float> curve =
+                std::span{edgeCurves_}.subspan(getEdgeCurveOffset<TNeighbors>(idx, direction), curveLen_);
+            for (float& ssim : curve) {
+                cmpShift += matchStep;
+
+                const cv::Rect cmpRoi = getRoiByCenter(miCenter + cmpShift, params_.patternSize);
+                wrapNeib.updateRoi(cmpRoi);
+
+                ssim = wrapAnchor.compare(wrapNeib);
+            }
+        }
+    }
+}
+
+template <cfg::concepts::CArrange TArrange>
+template <concepts::CNeighbors TNeighbors>
+PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighbors, cv::Mat& anchorI) const noexcept {
+    const int maxShift = params_.minPsize + curveLen_;
+    const MIBuffer& anchorMI = mis_.getMI(neighbors.getSelfIdx());
 
     float sumPsize = 0;
     float sumMetric = 0;
@@ -49,33 +178,22 @@ PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighb
             continue;
         }
 
-        const cv::Point2f anchorShift =
-            _hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction) * params_.patternShift;
-        const cv::Rect anchorRoi = getRoiByCenter(miCenter + anchorShift, params_.patternSize);
-        wrapAnchor.updateRoi(anchorRoi);
-
-        const MIBuffer& neibMI = mis_.getMI(neighbors.getNeighborIdx(direction));
-        WrapSSIM wrapNeib{neibMI};
-
-        const cv::Point2f matchStep = -_hp::sgn(arrange_.isKepler()) * TNeighbors::getUnitShift(direction);
-        cv::Point2f cmpShift = anchorShift + matchStep * params_.minPsize;
+        // SSIM of every candidate psize, starting from `minPsize`
+        const std::span<const float> ssims = getEdgeCurve(neighbors, direction);
 
         int bestPsize = 0;
         float maxSsim = std::numeric_limits<float>::lowest();
         for (const int psize : rgs::views::iota(params_.minPsize, maxShift)) {
-            cmpShift += matchStep;
-
-            const cv::Rect cmpRoi = getRoiByCenter(miCenter + cmpShift, params_.patternSize);
-            wrapNeib.updateRoi(cmpRoi);
-
-            const float ssim = wrapAnchor.compare(wrapNeib);
+            const float ssim = ssims[psize - params_.minPsize];
             if (ssim > maxSsim) {
                 maxSsim = ssim;
                 bestPsize = psize;
             }
         }
 
-        const float weight = computeGrads(wrapAnchor.I_);
+        // `Sobel` samples the pixels around a ROI as its border, so the anchor window is copied first
+        anchorMI.I(getAnchorRoi<TNeighbors>(direction)).copyTo(anchorI);
+        const float weight = computeGrads(anchorI);
         const float metric = maxSsim * maxSsim;
         const float weightedMetric = weight * metric;
         sumPsize += bestPsize * weightedMetric;
@@ -92,39 +210,17 @@ PsizeMetric PsizeImpl_<TArrange>::estimateWithNeighbors(const TNeighbors& neighb
 }
 
 template <cfg::concepts::CArrange TArrange>
-float PsizeImpl_<TArrange>::estimatePatchsize(TBridge& bridge, cv::Point index) const noexcept {
-    using PsizeParams = PsizeParams_<TArrange>;
+float PsizeImpl_<TArrange>::estimatePatchsize(cv::Point index) const noexcept {
+    cv::Mat anchorI;
 
-    const int offset = index.y * arrange_.getMIMaxCols() + index.x;
-    const MIBuffer& anchorMI = mis_.getMI(offset);
-    const float prevPsize = prevPatchInfos_[offset].getPatchsize();
-
-    WrapSSIM wrapAnchor{anchorMI};
     const NearNeighbors& nearNeighbors = NearNeighbors::fromArrangeAndIndex(arrange_, index);
-
-    if (prevPsize != PsizeParams::INVALID_PSIZE) [[likely]] {
-        const cv::Point2f miCenter{arrange_.getRadius(), arrange_.getRadius()};
-        const cv::Rect roi = getRoiByCenter(miCenter, arrange_.getDiameter() / std::numbers::sqrt2_v<float>);
-        wrapAnchor.updateRoi(roi);
-
-        const MIBuffer& prevMI = prevMis_.getMI(offset);
-        WrapSSIM wrapPrev{prevMI};
-        wrapPrev.updateRoi(roi);
-
-        const float ssim = wrapAnchor.compare(wrapPrev);
-        if (ssim >= params_.psizeShortcutThreshold) {
-            bridge.getInfo(offset).setInherited(true);
-            return prevPsize;
-        }
-    }
-
-    const PsizeMetric& nearPsizeMetric = estimateWithNeighbors<NearNeighbors>(nearNeighbors, wrapAnchor);
+    const PsizeMetric& nearPsizeMetric = estimateWithNeighbors<NearNeighbors>(nearNeighbors, anchorI);
     float maxMetric = nearPsizeMetric.metric;
     float bestPsize = nearPsizeMetric.psize;
 
     if (arrange_.isMultiFocus()) {
         const FarNeighbors& farNeighbors = FarNeighbors::fromArrangeAndIndex(arrange_, index);
-        const PsizeMetric& farPsizeMetric = estimateWithNeighbors<FarNeighbors>(farNeighbors, wrapAnchor);
+        const PsizeMetric& farPsizeMetric = estimateWithNeighbors<FarNeighbors>(farNeighbors, anchorI);
         if (farPsizeMetric.metric > maxMetric) {
             bestPsize = farPsizeMetric.psize;
         }
@@ -149,11 +245,11 @@ void PsizeImpl_<TArrange>::adjustWgtsAndPsizesForMultiFocus(TBridge& bridge) noe
 template <cfg::concepts::CArrange TArrange>
 auto PsizeImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvtCfg) noexcept
     -> std::expected<PsizeImpl_, Error> {
-    auto misRes = TMIBuffers::create(arrange);
+    auto misRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!misRes) return std::unexpected{std::move(misRes.error())};
     auto& mis = misRes.value();
 
-    auto prevMisRes = TMIBuffers::create(arrange);
+    auto prevMisRes = TMIBuffers::create(arrange, cvtCfg.bitDepth);
     if (!prevMisRes) return std::unexpected{std::move(prevMisRes.error())};
     auto& prevMis = prevMisRes.value();
 
@@ -163,7 +259,18 @@ auto PsizeImpl_<TArrange>::create(const TArrange& arrange, const TCvtConfig& cvt
     if (!paramsRes) return std::unexpected{std::move(paramsRes.error())};
     auto& params = paramsRes.value();
 
-    return PsizeImpl_{arrange, std::move(mis), std::move(prevMis), std::move(prevPatchInfos), params};
+    const int curveLen = std::max((int)(params.patternShift * 2) - params.minPsize, 0);
+    std::vector<float> edgeCurves;
+    std::vector<uint8_t> searchings;
+    try {
+        edgeCurves.resize(prevPatchInfos.size() * EDGE_SLOT_NUM * curveLen);
+        searchings.resize(prevPatchInfos.size(), false);
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    return PsizeImpl_{arrange, std::move(mis), std::move(prevMis), std::move(prevPatchInfos), std::move(edgeCurves),
+                      std::move(searchings), curveLen, params};
 }
 
 template <cfg::concepts::CArrange TArrange>
@@ -175,14 +282,30 @@ std::expected<void, Error> PsizeImpl_<TArrange>::updateBridge(const cv::Mat& src
     if (!updateRes) return std::unexpected{std::move(updateRes.error())};
 
 #pragma omp parallel for
-    for (int idx = 0; idx < (int)prevPatchInfos_.size(); idx++) {
+    for (int idx = 0; idx < (int)searchings_.size(); idx++) {
         const int row = idx / arrange_.getMIMaxCols();
         const int col = idx % arrange_.getMIMaxCols();
         if (col >= arrange_.getMICols(row)) {
             continue;
         }
+        searchings_[idx] = scheduleSearch(bridge, {col, row});
+    }
+
+    // Each edge is matched once and then read by both of its ends
+    matchEdges<NearNeighbors>();
+    if (arrange_.isMultiFocus()) {
+        matchEdges<FarNeighbors>();
+    }
+
+#pragma omp parallel for
+    for (int idx = 0; idx < (int)searchings_.size(); idx++) {
+        const int row = idx / arrange_.getMIMaxCols();
+        const int col = idx % arrange_.getMIMaxCols();
+        if (col >= arrange_.getMICols(row) || !searchings_[idx]) {
+            continue;
+        }
         const cv::Point index{col, row};
-        const float psize = estimatePatchsize(bridge, index);
+        const float psize = estimatePatchsize(index);
         bridge.getInfo(idx).setPatchsize(psize);
     }
 
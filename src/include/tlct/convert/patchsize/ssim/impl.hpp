@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #include <opencv2/core.hpp>
 
 #include "tlct/config/common.hpp"
@@ -35,15 +39,40 @@ private:
     using TPInfos = TBridge::TInfos;
 
     PsizeImpl_(const TArrange& arrange, TMIBuffers&& mis, TMIBuffers&& prevMis, TPInfos&& prevPatchInfos,
+               std::vector<float>&& edgeCurves, std::vector<uint8_t>&& searchings, int curveLen,
                const TPsizeParams& params) noexcept;
 
     using NearNeighbors = NearNeighbors_<TArrange>;
     using FarNeighbors = FarNeighbors_<TArrange>;
 
+    // Each MI owns the edges towards the second half of its neighbor directions
+    static constexpr int EDGE_SLOT_NUM = NearNeighbors::DIRECTION_NUM / 2 + FarNeighbors::DIRECTION_NUM / 2;
+
+    // The anchor window of the self MI of `neighbors`, on its edge facing `direction`
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] cv::Rect getAnchorRoi(typename TNeighbors::Direction direction) const noexcept;
+
+    // Where the curve of the edge between MI `miOffset` and its neighbor in the owned `direction` starts
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] size_t getEdgeCurveOffset(int miOffset, typename TNeighbors::Direction direction) const noexcept;
+
+    // SSIM of every candidate psize, as matched by the owner of the edge between the self MI of `neighbors` and its
+    // neighbor in `direction`. Both ends look for the same disparity, so the owner's curve stands for both of them.
+    template <concepts::CNeighbors TNeighbors>
+    [[nodiscard]] std::span<const float> getEdgeCurve(const TNeighbors& neighbors,
+                                                      typename TNeighbors::Direction direction) const noexcept;
+
+    // Inherits the previous psize when the MI barely changed, otherwise tells that it searches its neighbors
+    [[nodiscard]] bool scheduleSearch(TBridge& bridge, cv::Point index) const noexcept;
+
+    // Matches every edge with at least one searching end, once per edge
+    template <concepts::CNeighbors TNeighbors>
+    void matchEdges() noexcept;
+
     template <concepts::CNeighbors TNeighbors>
-    [[nodiscard]] PsizeMetric estimateWithNeighbors(const TNeighbors& neighbors, WrapSSIM& wrapAnchor) const noexcept;
+    [[nodiscard]] PsizeMetric estimateWithNeighbors(const TNeighbors& neighbors, cv::Mat& anchorI) const noexcept;
 
-    [[nodiscard]] float estimatePatchsize(TBridge& bridge, cv::Point index) const noexcept;
+    [[nodiscard]] float estimatePatchsize(cv::Point index) const noexcept;
 
     void adjustWgtsAndPsizesForMultiFocus(TBridge& bridge) noexcept;
 
@@ -69,6 +98,9 @@ private:
     TMIBuffers mis_;
     TMIBuffers prevMis_;
     TPInfos prevPatchInfos_;
+    std::vector<float> edgeCurves_;
+    std::vector<uint8_t> searchings_;  // whether each MI searches its neighbors in the current frame
+    int curveLen_;
     TPsizeParams params_;
 };
 
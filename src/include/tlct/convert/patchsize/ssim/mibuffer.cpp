@@ -27,19 +27,21 @@ MIBuffers_<TArrange>::MIBuffers_(TArrange&& arrange, Params&& params, std::vecto
       pBuffer_(std::move(pBuffer)) {}
 
 template <cfg::concepts::CArrange TArrange>
-MIBuffers_<TArrange>::Params::Params(const TArrange& arrange) noexcept {
+MIBuffers_<TArrange>::Params::Params(const TArrange& arrange, int bitDepth) noexcept {
     idiameter_ = _hp::iround(arrange.getDiameter());
     alignedMatSize_ = _hp::alignUp<SIMD_FETCH_SIZE>(idiameter_ * idiameter_ * sizeof(float));
     alignedMISize_ = 2 * alignedMatSize_;
     miMaxCols_ = arrange.getMIMaxCols();
     miNum_ = miMaxCols_ * arrange.getMIRows();
     bufferSize_ = miNum_ * alignedMISize_;
+    pixScale_ = 255.f / (float)((1 << bitDepth) - 1);
 }
 
 template <cfg::concepts::CArrange TArrange>
-auto MIBuffers_<TArrange>::create(const TArrange& arrange) noexcept -> std::expected<MIBuffers_, Error> {
+auto MIBuffers_<TArrange>::create(const TArrange& arrange, int bitDepth) noexcept
+    -> std::expected<MIBuffers_, Error> {
     auto copiedArrange = arrange;
-    Params params{arrange};
+    Params params{arrange, bitDepth};
     try {
         std::vector<MIBuffer> miBuffers(params.miNum_);
         auto pBuffer = std::make_unique_for_overwrite<std::byte[]>(params.bufferSize_ + Params::SIMD_FETCH_SIZE);
@@ -52,14 +54,15 @@ auto MIBuffers_<TArrange>::create(const TArrange& arrange) noexcept -> std::expe
 template <cfg::concepts::CArrange TArrange>
 std::expected<void, Error> MIBuffers_<TArrange>::update(const cv::Mat& src) noexcept {
     // TODO: handle `std::bad_alloc` in this func
-    if (src.type() != CV_8UC1) [[unlikely]] {
-        auto errMsg = std::format("MIBuffers::update expect CV_8UC1, got {}", src.type());
+    if (src.type() != CV_8UC1 && src.type() != CV_16UC1) [[unlikely]] {
+        auto errMsg = std::format("MIBuffers::update expect CV_8UC1 or CV_16UC1, got {}", src.type());
         return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
     }
 
     cv::Mat f32I;
     cv::Mat f32I2;
-    src.convertTo(f32I, CV_32FC1);
+    // Normalize to the 8bit range so that the SSIM constants still apply
+    src.convertTo(f32I, CV_32FC1, params_.pixScale_);
     cv::multiply(f32I, f32I, f32I2);
 
     uint8_t* bufBase = (uint8_t*)_hp::alignUp<Params::SIMD_FETCH_SIZE>((size_t)pBuffer_.get());
@@ -27,7 +27,7 @@ public:
         static constexpr size_t SIMD_FETCH_SIZE = 128 / 8;
 
         Params() = default;
-        Params(const TArrange& arrange) noexcept;
+        Params(const TArrange& arrange, int bitDepth) noexcept;
         Params& operator=(Params&& rhs) noexcept = default;
         Params(Params&& rhs) noexcept = default;
 
@@ -37,6 +37,7 @@ public:
         int idiameter_;
         int miMaxCols_;
         int miNum_;
+        float pixScale_;  // maps samples of `bitDepth` onto the 8bit range
     };
 
 private:
@@ -52,7 +53,8 @@ public:
     MIBuffers_(MIBuffers_&& rhs) noexcept = default;
 
     // Initialize from
-    [[nodiscard]] TLCT_API static std::expected<MIBuffers_, Error> create(const TArrange& arrange) noexcept;
+    [[nodiscard]] TLCT_API static std::expected<MIBuffers_, Error> create(const TArrange& arrange,
+                                                                          int bitDepth) noexcept;
 
     // Const methods
     [[nodiscard]] const MIBuffer& getMI(const int offset) const noexcept { return miBuffers_.at(offset); }
@@ -3,4 +3,5 @@
 #include "tlct/helper/charset.hpp"
 #include "tlct/helper/constexpr.hpp"
 #include "tlct/helper/math.hpp"
+#include "tlct/helper/mmap.hpp"
 #include "tlct/helper/std.hpp"
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cerrno>
+#include <format>
+#include <utility>
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/helper/mmap.hpp"
+#endif
+
+namespace tlct::_hp {
+
+MmapFile::MmapFile(std::byte* pData, size_t size) noexcept : pData_(pData), size_(size) {}
+
+MmapFile::MmapFile(MmapFile&& rhs) noexcept
+    : pData_(std::exchange(rhs.pData_, nullptr)), size_(std::exchange(rhs.size_, 0)) {}
+
+MmapFile& MmapFile::operator=(MmapFile&& rhs) noexcept {
+    if (this != &rhs) {
+        unmap();
+        pData_ = std::exchange(rhs.pData_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+MmapFile::~MmapFile() noexcept { unmap(); }
+
+#ifdef _WIN32
+
+std::expected<MmapFile, Error> MmapFile::createReadOnly(const fs::path& fpath) noexcept {
+    HANDLE hFile = CreateFileW(fpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) [[unlikely]] {
+        auto errMsg = std::format("failed to open read-only file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, GetLastError(), std::move(errMsg)}};
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) [[unlikely]] {
+        const DWORD errCode = GetLastError();
+        CloseHandle(hFile);
+        auto errMsg = std::format("failed to get file size. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, errCode, std::move(errMsg)}};
+    }
+
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(hFile);
+        return MmapFile{};
+    }
+
+    // The view keeps its own reference to the mapping object, so both handles can be closed right away
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    if (hMapping == nullptr) [[unlikely]] {
+        auto errMsg = std::format("failed to create file mapping. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, GetLastError(), std::move(errMsg)}};
+    }
+
+    void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+    if (pData == nullptr) [[unlikely]] {
+        auto errMsg = std::format("failed to map view of file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, GetLastError(), std::move(errMsg)}};
+    }
+
+    return MmapFile{(std::byte*)pData, (size_t)fileSize.QuadPart};
+}
+
+void MmapFile::unmap() noexcept {
+    if (pData_ != nullptr) {
+        UnmapViewOfFile(pData_);
+        pData_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void MmapFile::adviseSequential() const noexcept {
+    // `FILE_FLAG_SEQUENTIAL_SCAN` has been set when opening
+}
+
+void MmapFile::adviseWillNeed(size_t offset, size_t size) const noexcept {
+    if (offset >= size_) return;
+    WIN32_MEMORY_RANGE_ENTRY entry{pData_ + offset, std::min(size, size_ - offset)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0);
+}
+
+void MmapFile::adviseDontNeed([[maybe_unused]] size_t offset, [[maybe_unused]] size_t size) const noexcept {
+    // No cheap equivalent for read-only views, the working set trimmer will handle it
+}
+
+#else
+
+std::expected<MmapFile, Error> MmapFile::createReadOnly(const fs::path& fpath) noexcept {
+    const int fd = open(fpath.c_str(), O_RDONLY);
+    if (fd < 0) [[unlikely]] {
+        auto errMsg = std::format("failed to open read-only file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, errno, std::move(errMsg)}};
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) [[unlikely]] {
+        const int errCode = errno;
+        close(fd);
+        auto errMsg = std::format("failed to get file size. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, errCode, std::move(errMsg)}};
+    }
+
+    const size_t size = (size_t)fileStat.st_size;
+    if (size == 0) {
+        close(fd);
+        return MmapFile{};
+    }
+
+    // The mapping outlives the file descriptor
+    void* pData = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const int errCode = errno;
+    close(fd);
+    if (pData == MAP_FAILED) [[unlikely]] {
+        auto errMsg = std::format("failed to mmap file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, errCode, std::move(errMsg)}};
+    }
+
+    return MmapFile{(std::byte*)pData, size};
+}
+
+void MmapFile::unmap() noexcept {
+    if (pData_ != nullptr) {
+        munmap(pData_, size_);
+        pData_ = nullptr;
+        size_ = 0;
+    }
+}
+
+inline void adviseRange(std::byte* pData, size_t totalSize, size_t offset, size_t size, int advice) noexcept {
+    if (offset >= totalSize) return;
+    size = std::min(size, totalSize - offset);
+
+    // `madvise` requires a page-aligned address
+    static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t alignedOffset = offset / pageSize * pageSize;
+    size += offset - alignedOffset;
+
+    madvise(pData + alignedOffset, size, advice);
+}
+
+void MmapFile::adviseSequential() const noexcept {
+    if (pData_ == nullptr) return;
+    madvise(pData_, size_, MADV_SEQUENTIAL);
+}
+
+void MmapFile::adviseWillNeed(size_t offset, size_t size) const noexcept {
+    if (pData_ == nullptr) return;
+    adviseRange(pData_, size_, offset, size, MADV_WILLNEED);
+}
+
+void MmapFile::adviseDontNeed(size_t offset, size_t size) const noexcept {
+    if (pData_ == nullptr) return;
+    adviseRange(pData_, size_, offset, size, MADV_DONTNEED);
+}
+
+#endif
+
+}  // namespace tlct::_hp
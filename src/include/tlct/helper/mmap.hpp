@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_hp {
+
+namespace fs = std::filesystem;
+
+// Read-only memory mapping of a whole file.
+class MmapFile {
+    MmapFile(std::byte* pData, size_t size) noexcept;
+
+public:
+    // Constructor
+    MmapFile() noexcept : pData_(nullptr), size_(0) {}
+    MmapFile(const MmapFile& rhs) = delete;
+    MmapFile& operator=(const MmapFile& rhs) = delete;
+    TLCT_API MmapFile(MmapFile&& rhs) noexcept;
+    TLCT_API MmapFile& operator=(MmapFile&& rhs) noexcept;
+    TLCT_API ~MmapFile() noexcept;
+
+    // Initialize from
+    [[nodiscard]] TLCT_API static std::expected<MmapFile, Error> createReadOnly(const fs::path& fpath) noexcept;
+
+    // Const methods
+    [[nodiscard]] TLCT_API const std::byte* getData() const noexcept { return pData_; }
+    [[nodiscard]] TLCT_API size_t getSize() const noexcept { return size_; }
+
+    // Hints for the kernel page cache. Out-of-range parts are ignored.
+    TLCT_API void adviseSequential() const noexcept;
+    TLCT_API void adviseWillNeed(size_t offset, size_t size) const noexcept;
+    TLCT_API void adviseDontNeed(size_t offset, size_t size) const noexcept;
+
+private:
+    void unmap() noexcept;
+
+    std::byte* pData_;
+    size_t size_;
+};
+
+}  // namespace tlct::_hp
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/helper/mmap.cpp"
+#endif
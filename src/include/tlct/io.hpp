@@ -1,3 +1,6 @@
 #pragma once
 
+#include "tlct/io/common.hpp"
+#include "tlct/io/concepts.hpp"
+#include "tlct/io/y4m.hpp"
 #include "tlct/io/yuv.hpp"
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "tlct/io/common/async_writer.hpp"
+#include "tlct/io/common/prefetch_reader.hpp"
+#include "tlct/io/common/stdio.hpp"
+
+namespace tlct::io {
+
+namespace _ = _io;
+
+using _::AsyncWriter_;
+using _::PrefetchReader_;
+
+using _::getStdinPath;
+using _::getStdoutPath;
+using _::isStdioPath;
+using _::STDIO_PATH;
+
+}  // namespace tlct::io
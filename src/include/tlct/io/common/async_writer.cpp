@@ -0,0 +1,183 @@
+#include <condition_variable>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/concepts/writer.hpp"
+#include "tlct/io/y4m/writer.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+#include "tlct/io/yuv/planar/writer.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/async_writer.hpp"
+#endif
+
+namespace tlct::_io {
+
+namespace rgs = std::ranges;
+
+template <concepts::CFrameWriter TWriter>
+struct AsyncWriter_<TWriter>::Shared {
+    Shared(std::vector<TWriter>&& writers, std::vector<YuvPlanarFrame>&& ring) noexcept
+        : writers(std::move(writers)),
+          ring(std::move(ring)),
+          writerIdxs(this->ring.size()),
+          head(0),
+          filled(0),
+          stop(false) {}
+    ~Shared() noexcept {
+        {
+            std::lock_guard lock{mtx};
+            stop = true;
+        }
+        filledCv.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void consume() noexcept {
+        while (true) {
+            size_t slot;
+            {
+                std::unique_lock lock{mtx};
+                filledCv.wait(lock, [this] { return stop || filled > 0; });
+                // Drain the queue before quitting
+                if (filled == 0) return;
+                slot = head;
+            }
+
+            // The slot stays counted in `filled` until written, so the producer never touches it meanwhile
+            auto writeRes = writers[writerIdxs[slot]].write(ring[slot]);
+
+            {
+                std::lock_guard lock{mtx};
+                if (writeRes) [[likely]] {
+                    head = (head + 1) % ring.size();
+                    filled--;
+                } else {
+                    // Drop everything still queued, the error is sticky
+                    error = std::move(writeRes.error());
+                    head = (head + filled) % ring.size();
+                    filled = 0;
+                }
+            }
+            freeCv.notify_all();
+        }
+    }
+
+    std::vector<TWriter> writers;
+    std::vector<YuvPlanarFrame> ring;
+    std::vector<int> writerIdxs;
+    size_t head;
+    size_t filled;
+    bool stop;
+    std::optional<Error> error;
+
+    std::mutex mtx;
+    std::condition_variable freeCv;
+    std::condition_variable filledCv;
+    std::thread worker;
+};
+
+template <concepts::CFrameWriter TWriter>
+AsyncWriter_<TWriter>::AsyncWriter_(std::unique_ptr<Shared>&& pShared) noexcept : pShared_(std::move(pShared)) {}
+
+template <concepts::CFrameWriter TWriter>
+AsyncWriter_<TWriter>::AsyncWriter_(AsyncWriter_&& rhs) noexcept = default;
+
+template <concepts::CFrameWriter TWriter>
+AsyncWriter_<TWriter>& AsyncWriter_<TWriter>::operator=(AsyncWriter_&& rhs) noexcept = default;
+
+template <concepts::CFrameWriter TWriter>
+AsyncWriter_<TWriter>::~AsyncWriter_() noexcept = default;
+
+template <concepts::CFrameWriter TWriter>
+auto AsyncWriter_<TWriter>::create(std::vector<TWriter>&& writers, const YuvPlanarExtent& extent,
+                                   int capacity) noexcept -> std::expected<AsyncWriter_, Error> {
+    if (capacity <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect capacity > 0, got: {}", capacity);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    std::unique_ptr<Shared> pShared;
+    try {
+        std::vector<YuvPlanarFrame> ring;
+        ring.reserve(capacity);
+        for ([[maybe_unused]] const int i : rgs::views::iota(0, capacity)) {
+            auto frameRes = YuvPlanarFrame::create(extent);
+            if (!frameRes) [[unlikely]] {
+                return std::unexpected{std::move(frameRes.error())};
+            }
+            ring.push_back(std::move(frameRes.value()));
+        }
+        pShared = std::make_unique<Shared>(std::move(writers), std::move(ring));
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    try {
+        pShared->worker = std::thread{[pRawShared = pShared.get()] { pRawShared->consume(); }};
+    } catch (const std::system_error& err) {
+        auto errMsg = std::format("failed to start writer thread. what={}", err.what());
+        return std::unexpected{Error{ECate::eSys, err.code().value(), std::move(errMsg)}};
+    }
+
+    return AsyncWriter_{std::move(pShared)};
+}
+
+template <concepts::CFrameWriter TWriter>
+std::expected<void, Error> AsyncWriter_<TWriter>::write(int writerIdx, YuvPlanarFrame& frame) noexcept {
+    Shared& shared = *pShared_;
+
+    if (writerIdx < 0 || writerIdx >= (int)shared.writers.size()) [[unlikely]] {
+        auto errMsg = std::format("expect 0 <= writerIdx < {}, got: {}", shared.writers.size(), writerIdx);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    {
+        std::unique_lock lock{shared.mtx};
+        shared.freeCv.wait(lock, [&shared] { return shared.filled < shared.ring.size() || shared.error.has_value(); });
+
+        if (shared.error.has_value()) [[unlikely]] {
+            return std::unexpected{shared.error.value()};
+        }
+
+        const size_t slot = (shared.head + shared.filled) % shared.ring.size();
+        std::swap(frame, shared.ring[slot]);
+        shared.writerIdxs[slot] = writerIdx;
+        shared.filled++;
+    }
+    shared.filledCv.notify_one();
+
+    return {};
+}
+
+template <concepts::CFrameWriter TWriter>
+std::expected<void, Error> AsyncWriter_<TWriter>::flush() noexcept {
+    Shared& shared = *pShared_;
+
+    std::unique_lock lock{shared.mtx};
+    shared.freeCv.wait(lock, [&shared] { return shared.filled == 0; });
+
+    if (shared.error.has_value()) [[unlikely]] {
+        return std::unexpected{shared.error.value()};
+    }
+
+    return {};
+}
+
+template class AsyncWriter_<YuvPlanarWriter>;
+template class AsyncWriter_<Y4mWriter>;
+
+}  // namespace tlct::_io
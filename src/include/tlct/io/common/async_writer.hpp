@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/concepts/writer.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io {
+
+// Write-behind fan-out over a set of writers. Queued frames are flushed in order by a dedicated I/O thread.
+// The queue is a bounded ring of pre-allocated frames, so `write` only blocks when the I/O thread falls behind.
+template <concepts::CFrameWriter TWriter_>
+class AsyncWriter_ {
+public:
+    // Typename alias
+    using TWriter = TWriter_;
+
+private:
+    struct Shared;
+
+    AsyncWriter_(std::unique_ptr<Shared>&& pShared) noexcept;
+
+public:
+    // Constructor
+    AsyncWriter_() = delete;
+    AsyncWriter_(const AsyncWriter_& rhs) = delete;
+    AsyncWriter_& operator=(const AsyncWriter_& rhs) = delete;
+    TLCT_API AsyncWriter_(AsyncWriter_&& rhs) noexcept;
+    TLCT_API AsyncWriter_& operator=(AsyncWriter_&& rhs) noexcept;
+    TLCT_API ~AsyncWriter_() noexcept;
+
+    // Initialize from
+    [[nodiscard]] TLCT_API static std::expected<AsyncWriter_, Error> create(std::vector<TWriter>&& writers,
+                                                                            const YuvPlanarExtent& extent,
+                                                                            int capacity) noexcept;
+
+    // Non-const methods
+    // Queue `frame` for `writers[writerIdx]`. The buffer of `frame` is handed over to the queue and `frame`
+    // receives a recycled one, so `frame` must be an owning frame with the same extent.
+    // Errors raised by the I/O thread are reported by the next `write` or `flush`.
+    [[nodiscard]] TLCT_API std::expected<void, Error> write(int writerIdx, YuvPlanarFrame& frame) noexcept;
+    // Block until every queued frame has been written.
+    [[nodiscard]] TLCT_API std::expected<void, Error> flush() noexcept;
+
+private:
+    std::unique_ptr<Shared> pShared_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/async_writer.cpp"
+#endif
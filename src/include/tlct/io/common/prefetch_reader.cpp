@@ -0,0 +1,228 @@
+#include <condition_variable>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/concepts/reader.hpp"
+#include "tlct/io/y4m/reader.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+#include "tlct/io/yuv/planar/mmap_reader.hpp"
+#include "tlct/io/yuv/planar/reader.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/prefetch_reader.hpp"
+#endif
+
+namespace tlct::_io {
+
+namespace rgs = std::ranges;
+
+template <concepts::CFrameReader TReader>
+struct PrefetchReader_<TReader>::Shared {
+    Shared(TReader&& reader, std::vector<YuvPlanarFrame>&& ring, int frameCount, int frameStep) noexcept
+        : reader(std::move(reader)),
+          ring(std::move(ring)),
+          head(0),
+          filled(0),
+          remaining(frameCount),
+          frameStep(frameStep),
+          stop(false),
+          reading(false) {}
+
+    std::expected<void, Error> fill(YuvPlanarFrame& frame) noexcept {
+        if constexpr (std::is_same_v<TReader, YuvPlanarMmapReader>) {
+            // Zero-copy: the slot becomes a view into the mapping, whose next frame is already advised as needed
+            auto frameRes = reader.read();
+            if (!frameRes) [[unlikely]] {
+                return std::unexpected{std::move(frameRes.error())};
+            }
+            frame = std::move(frameRes.value());
+            return {};
+        } else {
+            return reader.readInto(frame);
+        }
+    }
+
+    void produce() noexcept {
+        while (true) {
+            size_t slot;
+            {
+                std::unique_lock lock{mtx};
+                freeCv.wait(lock, [this] { return stop || filled < ring.size(); });
+                if (stop) return;
+                slot = (head + filled) % ring.size();
+                reading = true;
+            }
+
+            // The slot is invisible to the consumer until `filled` is bumped, so no lock is needed here
+            auto readRes = fill(ring[slot]);
+            // `remaining` is only written by this thread
+            std::expected<void, Error> skipRes{};
+            if (readRes && frameStep > 1 && remaining > 1) {
+                skipRes = reader.skip(frameStep - 1);
+            }
+
+            bool done;
+            {
+                std::lock_guard lock{mtx};
+                reading = false;
+                if (readRes) [[likely]] {
+                    filled++;
+                    remaining--;
+                    if (!skipRes) [[unlikely]] {
+                        error = std::move(skipRes.error());
+                    }
+                } else {
+                    error = std::move(readRes.error());
+                }
+                done = remaining == 0 || error.has_value();
+            }
+            filledCv.notify_one();
+
+            if (done) return;
+        }
+    }
+
+    TReader reader;
+    std::vector<YuvPlanarFrame> ring;
+    size_t head;
+    size_t filled;
+    int remaining;
+    int frameStep;
+    bool stop;
+    bool reading;  // the worker is inside `reader`, which may block forever on a pipe
+    std::optional<Error> error;
+
+    std::mutex mtx;
+    std::condition_variable freeCv;
+    std::condition_variable filledCv;
+    std::thread worker;
+};
+
+template <concepts::CFrameReader TReader>
+PrefetchReader_<TReader>::PrefetchReader_(std::shared_ptr<Shared>&& pShared) noexcept
+    : pShared_(std::move(pShared)) {}
+
+template <concepts::CFrameReader TReader>
+PrefetchReader_<TReader>::PrefetchReader_(PrefetchReader_&& rhs) noexcept = default;
+
+template <concepts::CFrameReader TReader>
+PrefetchReader_<TReader>& PrefetchReader_<TReader>::operator=(PrefetchReader_&& rhs) noexcept {
+    // The old worker is stopped by the destructor of `rhs`
+    std::swap(pShared_, rhs.pShared_);
+    return *this;
+}
+
+template <concepts::CFrameReader TReader>
+PrefetchReader_<TReader>::~PrefetchReader_() noexcept {
+    if (pShared_ == nullptr) return;
+
+    bool reading;
+    {
+        std::lock_guard lock{pShared_->mtx};
+        pShared_->stop = true;
+        reading = pShared_->reading;
+    }
+    pShared_->freeCv.notify_one();
+
+    if (!pShared_->worker.joinable()) return;
+    if (reading) {
+        // A read from stdin or a pipe only returns when the writer sends data or closes it.
+        // The worker holds its own reference to `Shared` and exits right after that read.
+        pShared_->worker.detach();
+    } else {
+        pShared_->worker.join();
+    }
+}
+
+template <concepts::CFrameReader TReader>
+auto PrefetchReader_<TReader>::create(TReader&& reader, const YuvPlanarExtent& extent, int capacity, int frameCount,
+                                      int frameStep) noexcept -> std::expected<PrefetchReader_, Error> {
+    if (capacity <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect capacity > 0, got: {}", capacity);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (frameCount < 0) [[unlikely]] {
+        auto errMsg = std::format("expect frameCount >= 0, got: {}", frameCount);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    if (frameStep <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect frameStep > 0, got: {}", frameStep);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    std::shared_ptr<Shared> pShared;
+    try {
+        // The mmap backend drops these buffers for views on its first fill
+        std::vector<YuvPlanarFrame> ring;
+        ring.reserve(capacity);
+        for ([[maybe_unused]] const int i : rgs::views::iota(0, capacity)) {
+            auto frameRes = YuvPlanarFrame::create(extent);
+            if (!frameRes) [[unlikely]] {
+                return std::unexpected{std::move(frameRes.error())};
+            }
+            ring.push_back(std::move(frameRes.value()));
+        }
+        pShared = std::make_shared<Shared>(std::move(reader), std::move(ring), frameCount, frameStep);
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    if (frameCount > 0) {
+        try {
+            pShared->worker = std::thread{[pWorkerShared = pShared] { pWorkerShared->produce(); }};
+        } catch (const std::system_error& err) {
+            auto errMsg = std::format("failed to start prefetch thread. what={}", err.what());
+            return std::unexpected{Error{ECate::eSys, err.code().value(), std::move(errMsg)}};
+        }
+    }
+
+    return PrefetchReader_{std::move(pShared)};
+}
+
+template <concepts::CFrameReader TReader>
+std::expected<void, Error> PrefetchReader_<TReader>::readInto(YuvPlanarFrame& frame) noexcept {
+    Shared& shared = *pShared_;
+
+    {
+        std::unique_lock lock{shared.mtx};
+        shared.filledCv.wait(lock, [&shared] {
+            return shared.filled > 0 || shared.remaining == 0 || shared.error.has_value();
+        });
+
+        if (shared.filled == 0) [[unlikely]] {
+            // Frames read before the error are always delivered first
+            if (shared.error.has_value()) {
+                return std::unexpected{std::move(shared.error.value())};
+            }
+            auto errMsg = std::format("no more prefetched frames");
+            return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, std::move(errMsg)}};
+        }
+
+        std::swap(frame, shared.ring[shared.head]);
+        shared.head = (shared.head + 1) % shared.ring.size();
+        shared.filled--;
+    }
+    shared.freeCv.notify_one();
+
+    return {};
+}
+
+template class PrefetchReader_<YuvPlanarReader>;
+template class PrefetchReader_<YuvPlanarMmapReader>;
+template class PrefetchReader_<Y4mReader>;
+
+}  // namespace tlct::_io
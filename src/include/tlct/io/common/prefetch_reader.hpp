@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/concepts/reader.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io {
+
+// Reads ahead on a background thread into a bounded ring of pre-allocated frames.
+// The producer blocks when the ring is full, so at most `capacity` frames are in flight.
+// Destroying the reader stops the producer. A producer blocked in a read from stdin or a pipe is detached
+// rather than joined, and it exits once that read returns.
+template <concepts::CFrameReader TReader_>
+class PrefetchReader_ {
+public:
+    // Typename alias
+    using TReader = TReader_;
+
+private:
+    struct Shared;
+
+    PrefetchReader_(std::shared_ptr<Shared>&& pShared) noexcept;
+
+public:
+    // Constructor
+    PrefetchReader_() = delete;
+    PrefetchReader_(const PrefetchReader_& rhs) = delete;
+    PrefetchReader_& operator=(const PrefetchReader_& rhs) = delete;
+    TLCT_API PrefetchReader_(PrefetchReader_&& rhs) noexcept;
+    TLCT_API PrefetchReader_& operator=(PrefetchReader_&& rhs) noexcept;
+    TLCT_API ~PrefetchReader_() noexcept;
+
+    // Initialize from
+    // `reader` should already be positioned. It stops after `frameCount` frames,
+    // skipping `frameStep - 1` frames after each one.
+    [[nodiscard]] TLCT_API static std::expected<PrefetchReader_, Error> create(TReader&& reader,
+                                                                               const YuvPlanarExtent& extent,
+                                                                               int capacity, int frameCount,
+                                                                               int frameStep = 1) noexcept;
+
+    // Non-const methods
+    // Swap the next prefetched frame into `frame`. The old buffer of `frame` is recycled into the ring,
+    // so `frame` must be an owning frame with the same extent.
+    // With `YuvPlanarMmapReader`, the frames given out are views into the mapping instead, as the ones of its `read()`.
+    // They remain valid as long as this reader is alive.
+    [[nodiscard]] TLCT_API std::expected<void, Error> readInto(YuvPlanarFrame& frame) noexcept;
+
+private:
+    std::shared_ptr<Shared> pShared_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/prefetch_reader.cpp"
+#endif
@@ -0,0 +1,35 @@
+#include <filesystem>
+#include <format>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/stdio.hpp"
+#endif
+
+namespace tlct::_io {
+
+bool isStdioPath(const fs::path& fpath) noexcept { return fpath == STDIO_PATH; }
+
+#ifdef _WIN32
+
+std::expected<fs::path, Error> getStdinPath() noexcept {
+    auto errMsg = std::format("reading from stdin is not supported on Windows");
+    return std::unexpected{Error{ECate::eTLCT, ECode::eNoSupport, std::move(errMsg)}};
+}
+
+std::expected<fs::path, Error> getStdoutPath() noexcept {
+    auto errMsg = std::format("writing to stdout is not supported on Windows");
+    return std::unexpected{Error{ECate::eTLCT, ECode::eNoSupport, std::move(errMsg)}};
+}
+
+#else
+
+std::expected<fs::path, Error> getStdinPath() noexcept { return fs::path{"/dev/stdin"}; }
+
+std::expected<fs::path, Error> getStdoutPath() noexcept { return fs::path{"/dev/stdout"}; }
+
+#endif
+
+}  // namespace tlct::_io
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+
+namespace tlct::_io {
+
+namespace fs = std::filesystem;
+
+// `-` stands for stdin when reading and stdout when writing
+constexpr std::string_view STDIO_PATH = "-";
+
+[[nodiscard]] TLCT_API bool isStdioPath(const fs::path& fpath) noexcept;
+// Path that can be opened by `std::ifstream`/`std::ofstream` to reach stdin/stdout
+[[nodiscard]] TLCT_API std::expected<fs::path, Error> getStdinPath() noexcept;
+[[nodiscard]] TLCT_API std::expected<fs::path, Error> getStdoutPath() noexcept;
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/common/stdio.cpp"
+#endif
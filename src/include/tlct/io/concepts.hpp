@@ -0,0 +1,13 @@
+#pragma once
+
+#include "tlct/io/concepts/reader.hpp"
+#include "tlct/io/concepts/writer.hpp"
+
+namespace tlct::io::concepts {
+
+namespace _ = _io::concepts;
+
+using _::CFrameReader;
+using _::CFrameWriter;
+
+}  // namespace tlct::io::concepts
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <concepts>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io::concepts {
+
+template <typename Self>
+concept CFrameReader = std::movable<Self> && requires {
+    // Non-const methods
+    requires requires(Self self, YuvPlanarFrame& frame) {
+        { self.readInto(frame) } -> std::same_as<std::expected<void, Error>>;
+    };
+    requires requires(Self self, int frameCount) {
+        { self.skip(frameCount) } -> std::same_as<std::expected<void, Error>>;
+    };
+};
+
+}  // namespace tlct::_io::concepts
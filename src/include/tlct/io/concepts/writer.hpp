@@ -0,0 +1,19 @@
+#pragma once
+
+#include <concepts>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io::concepts {
+
+template <typename Self>
+concept CFrameWriter = std::movable<Self> && requires {
+    // Non-const methods
+    requires requires(Self self, const YuvPlanarFrame& frame) {
+        { self.write(frame) } -> std::same_as<std::expected<void, Error>>;
+    };
+};
+
+}  // namespace tlct::_io::concepts
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "tlct/io/y4m/header.hpp"
+#include "tlct/io/y4m/reader.hpp"
+#include "tlct/io/y4m/writer.hpp"
+
+namespace tlct::io {
+
+namespace _ = _io;
+
+using _io::Y4mHeader;
+using _io::Y4mReader;
+using _io::Y4mWriter;
+
+}  // namespace tlct::io
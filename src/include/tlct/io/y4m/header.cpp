@@ -0,0 +1,144 @@
+#include <charconv>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/header.hpp"
+#endif
+
+namespace tlct::_io {
+
+inline bool parseInt(std::string_view str, int& val) noexcept {
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+    return ec == std::errc{} && ptr == str.data() + str.size();
+}
+
+// Parse the `C` tag, e.g. `420jpeg`, `420p10`, `444p16`
+inline bool parseColorspace(std::string_view cspace, int& shift, int& bitDepth) noexcept {
+    if (cspace.starts_with("420")) {
+        shift = 1;
+    } else if (cspace.starts_with("444") && !cspace.starts_with("444alpha")) {
+        shift = 0;
+    } else {
+        return false;
+    }
+    cspace.remove_prefix(3);
+
+    if (cspace.empty() || cspace == "jpeg" || cspace == "paldv" || cspace == "mpeg2") {
+        bitDepth = 8;
+        return true;
+    }
+
+    if (cspace.starts_with('p')) {
+        cspace.remove_prefix(1);
+        return parseInt(cspace, bitDepth);
+    }
+
+    return false;
+}
+
+Y4mHeader::Y4mHeader(const YuvPlanarExtent& extent, int fpsNum, int fpsDen) noexcept
+    : extent_(extent), fpsNum_(fpsNum), fpsDen_(fpsDen) {}
+
+std::expected<Y4mHeader, Error> Y4mHeader::create(const YuvPlanarExtent& extent, int fpsNum, int fpsDen) noexcept {
+    if (extent.getUShift() != extent.getVShift() || extent.getUShift() > 1) [[unlikely]] {
+        auto errMsg = std::format("y4m only supports 420 or 444, got uShift={} vShift={}", extent.getUShift(),
+                                  extent.getVShift());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eNoSupport, std::move(errMsg)}};
+    }
+
+    if (fpsNum <= 0 || fpsDen <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect positive frame rate, got {}:{}", fpsNum, fpsDen);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    return Y4mHeader{extent, fpsNum, fpsDen};
+}
+
+std::expected<Y4mHeader, Error> Y4mHeader::createFromLine(std::string_view line) noexcept {
+    if (!line.starts_with(MAGIC)) [[unlikely]] {
+        auto errMsg = std::format("not a y4m stream, the header should start with {}", MAGIC);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+    line.remove_prefix(MAGIC.size());
+
+    int width = 0;
+    int height = 0;
+    int fpsNum = 30;
+    int fpsDen = 1;
+    int shift = 1;
+    int bitDepth = 8;
+
+    while (!line.empty()) {
+        const size_t sepPos = line.find(' ');
+        const std::string_view token = line.substr(0, sepPos);
+        line.remove_prefix(sepPos == std::string_view::npos ? line.size() : sepPos + 1);
+        if (token.empty()) continue;
+
+        const char tag = token[0];
+        const std::string_view value = token.substr(1);
+        bool ok = true;
+        switch (tag) {
+            case 'W':
+                ok = parseInt(value, width);
+                break;
+            case 'H':
+                ok = parseInt(value, height);
+                break;
+            case 'F': {
+                const size_t colonPos = value.find(':');
+                ok = colonPos != std::string_view::npos && parseInt(value.substr(0, colonPos), fpsNum) &&
+                     parseInt(value.substr(colonPos + 1), fpsDen);
+                break;
+            }
+            case 'C':
+                if (!parseColorspace(value, shift, bitDepth)) [[unlikely]] {
+                    auto errMsg = std::format("unsupported y4m colorspace C{}", value);
+                    return std::unexpected{Error{ECate::eTLCT, ECode::eNoSupport, std::move(errMsg)}};
+                }
+                break;
+            default:
+                // Interlacing, aspect ratio and extensions do not affect the layout
+                break;
+        }
+
+        if (!ok) [[unlikely]] {
+            auto errMsg = std::format("malformed y4m header token {}", token);
+            return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+        }
+    }
+
+    if (width <= 0 || height <= 0) [[unlikely]] {
+        auto errMsg = std::format("expect positive y4m frame size, got {}x{}", width, height);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    auto extentRes = YuvPlanarExtent::createWithBitDepth(width, height, bitDepth, shift, shift);
+    if (!extentRes) [[unlikely]] {
+        return std::unexpected{std::move(extentRes.error())};
+    }
+
+    return create(extentRes.value(), fpsNum, fpsDen);
+}
+
+std::string Y4mHeader::toLine() const noexcept {
+    const int bitDepth = extent_.getBitDepth();
+    const std::string_view chroma = extent_.getUShift() == 1 ? "420" : "444";
+
+    std::string cspace;
+    if (bitDepth == 8) {
+        cspace = extent_.getUShift() == 1 ? "420jpeg" : "444";
+    } else {
+        cspace = std::format("{}p{}", chroma, bitDepth);
+    }
+
+    return std::format("{} W{} H{} F{}:{} Ip A1:1 C{}\n", MAGIC, extent_.getYWidth(), extent_.getYHeight(), fpsNum_,
+                       fpsDen_, cspace);
+}
+
+}  // namespace tlct::_io
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+
+namespace tlct::_io {
+
+// The stream header of a YUV4MPEG2 file, e.g. `YUV4MPEG2 W1920 H1080 F30:1 Ip A1:1 C420jpeg`.
+// Only the chroma layouts expressible by `YuvPlanarExtent` are supported: 420 and 444 with 8-16bit samples.
+class Y4mHeader {
+    Y4mHeader(const YuvPlanarExtent& extent, int fpsNum, int fpsDen) noexcept;
+
+public:
+    static constexpr std::string_view MAGIC = "YUV4MPEG2";
+    static constexpr std::string_view FRAME_MAGIC = "FRAME";
+    // Header lines longer than this are considered malformed
+    static constexpr size_t MAX_LINE_LENGTH = 1024;
+
+    // Initialize from
+    [[nodiscard]] TLCT_API static std::expected<Y4mHeader, Error> create(const YuvPlanarExtent& extent, int fpsNum,
+                                                                         int fpsDen) noexcept;
+    // `line` should not contain the trailing `\n`
+    [[nodiscard]] TLCT_API static std::expected<Y4mHeader, Error> createFromLine(std::string_view line) noexcept;
+
+    // Const methods
+    [[nodiscard]] TLCT_API const YuvPlanarExtent& getExtent() const noexcept { return extent_; }
+    [[nodiscard]] TLCT_API int getFpsNum() const noexcept { return fpsNum_; }
+    [[nodiscard]] TLCT_API int getFpsDen() const noexcept { return fpsDen_; }
+    // With the trailing `\n`
+    [[nodiscard]] TLCT_API std::string toLine() const noexcept;
+
+private:
+    YuvPlanarExtent extent_;
+    int fpsNum_;
+    int fpsDen_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/header.cpp"
+#endif
@@ -0,0 +1,232 @@
+#include <format>
+#include <ios>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/y4m/header.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/reader.hpp"
+#endif
+
+namespace tlct::_io {
+
+// Read one `\n`-terminated line without the `\n`
+inline bool readLine(std::ifstream& ifs, std::string& line) noexcept {
+    line.clear();
+    char ch;
+    while (ifs.get(ch)) {
+        if (ch == '\n') return true;
+        if (line.size() >= Y4mHeader::MAX_LINE_LENGTH) return false;
+        line.push_back(ch);
+    }
+    return false;
+}
+
+inline bool isFrameLine(std::string_view line) noexcept {
+    return line.starts_with(Y4mHeader::FRAME_MAGIC) &&
+           (line.size() == Y4mHeader::FRAME_MAGIC.size() || line[Y4mHeader::FRAME_MAGIC.size()] == ' ');
+}
+
+// Probe whether a bare `FRAME\n` sits at `offset`
+inline bool hasBareFrameLine(std::ifstream& ifs, std::streamoff offset, std::string& line) noexcept {
+    ifs.clear();
+    ifs.seekg(offset);
+    return readLine(ifs, line) && line == Y4mHeader::FRAME_MAGIC;
+}
+
+// Hop over the frame lines from `dataBegin`, the payloads are never read
+inline std::expected<void, Error> hopFrameOffsets(std::ifstream& ifs, const std::streamoff dataBegin,
+                                                  const std::streamoff fileSize, const std::streamoff payloadSize,
+                                                  std::string& line, std::vector<std::streamoff>& frameOffsets) {
+    frameOffsets.clear();
+    ifs.clear();
+    std::streamoff offset = dataBegin;
+    while (offset < fileSize) {
+        ifs.seekg(offset);
+        if (!readLine(ifs, line) || !isFrameLine(line)) [[unlikely]] {
+            auto errMsg = std::format("malformed y4m frame header at offset {}", (long long)offset);
+            return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+        }
+
+        const std::streamoff payloadOffset = ifs.tellg();
+        // Drop the truncated trailing frame
+        if (payloadOffset + payloadSize > fileSize) break;
+
+        frameOffsets.push_back(payloadOffset);
+        offset = payloadOffset + payloadSize;
+    }
+    ifs.clear();
+    return {};
+}
+
+Y4mReader::Y4mReader(std::ifstream&& ifs, const Y4mHeader& header, std::string&& line,
+                     std::vector<std::streamoff>&& frameOffsets, const bool indexVerified,
+                     const std::streamoff dataBegin, const std::streamoff fileSize) noexcept
+    : ifs_(std::move(ifs)),
+      header_(header),
+      line_(std::move(line)),
+      frameOffsets_(std::move(frameOffsets)),
+      indexVerified_(indexVerified),
+      dataBegin_(dataBegin),
+      fileSize_(fileSize),
+      frameIdx_(0) {}
+
+std::expected<Y4mReader, Error> Y4mReader::create(const fs::path& fpath) noexcept {
+    std::error_code errCode;
+    const std::streamoff fileSize = (std::streamoff)fs::file_size(fpath, errCode);
+    if (errCode) [[unlikely]] {
+        auto errMsg = std::format("failed to get file size. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, errCode.value(), std::move(errMsg)}};
+    }
+
+    std::ifstream ifs{fpath, std::ios::binary};
+    if (!ifs.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to open read-only file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, ifs.rdstate(), std::move(errMsg)}};
+    }
+
+    std::string line;
+    try {
+        line.reserve(Y4mHeader::MAX_LINE_LENGTH);
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    if (!readLine(ifs, line)) [[unlikely]] {
+        auto errMsg = std::format("failed to read y4m header. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    auto headerRes = Y4mHeader::createFromLine(line);
+    if (!headerRes) [[unlikely]] {
+        return std::unexpected{std::move(headerRes.error())};
+    }
+    const auto& header = headerRes.value();
+
+    const std::streamoff payloadSize = header.getExtent().getTotalByteSize();
+    const std::streamoff frameLineSize = (std::streamoff)Y4mHeader::FRAME_MAGIC.size() + 1;
+    const std::streamoff dataBegin = ifs.tellg();
+
+    std::vector<std::streamoff> frameOffsets;
+    bool indexVerified = false;
+    try {
+        // Fast path: every frame carries a bare `FRAME\n`, so the index is pure arithmetic.
+        // Only the first and the last frame line are probed here, `readInto` checks the line of every frame it reads.
+        const std::streamoff stride = frameLineSize + payloadSize;
+        const std::streamoff dataSize = fileSize - dataBegin;
+        const std::streamoff frameCount = dataSize / stride;
+        if (dataSize % stride == 0 && hasBareFrameLine(ifs, dataBegin, line) &&
+            hasBareFrameLine(ifs, dataBegin + (frameCount - 1) * stride, line)) {
+            frameOffsets.reserve(frameCount);
+            for (std::streamoff offset = dataBegin + frameLineSize; offset < fileSize; offset += stride) {
+                frameOffsets.push_back(offset);
+            }
+        } else {
+            auto hopRes = hopFrameOffsets(ifs, dataBegin, fileSize, payloadSize, line, frameOffsets);
+            if (!hopRes) [[unlikely]] {
+                auto errMsg = std::format("{}. path={}", hopRes.error().msg, fpath.string());
+                return std::unexpected{Error{hopRes.error().cate, hopRes.error().code, std::move(errMsg)}};
+            }
+            indexVerified = true;
+        }
+    } catch (const std::bad_alloc&) {
+        return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+    }
+
+    ifs.clear();
+    return Y4mReader{std::move(ifs), header, std::move(line), std::move(frameOffsets), indexVerified, dataBegin,
+                     fileSize};
+}
+
+std::expected<void, Error> Y4mReader::seek(int frameIdx) noexcept {
+    if (frameIdx < 0 || frameIdx > getFrameCount()) [[unlikely]] {
+        auto errMsg = std::format("expect 0 <= frameIdx <= {}, got: {}", getFrameCount(), frameIdx);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    frameIdx_ = frameIdx;
+    return {};
+}
+
+std::expected<void, Error> Y4mReader::skip(int frameCount) noexcept { return seek(frameIdx_ + frameCount); }
+
+std::expected<YuvPlanarFrame, Error> Y4mReader::read() noexcept {
+    auto frameRes = YuvPlanarFrame::create(getExtent());
+    if (!frameRes) [[unlikely]] {
+        return frameRes;
+    }
+    auto& frame = frameRes.value();
+
+    auto readRes = readInto(frame);
+    if (!readRes) [[unlikely]] {
+        return std::unexpected{std::move(readRes.error())};
+    }
+
+    return std::move(frame);
+}
+
+std::expected<void, Error> Y4mReader::readInto(YuvPlanarFrame& frame) noexcept {
+    if (frameIdx_ >= getFrameCount()) [[unlikely]] {
+        auto errMsg = std::format("failed to read, frameIdx={} exceeds frame count {}", frameIdx_, getFrameCount());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, std::move(errMsg)}};
+    }
+
+    if (!indexVerified_) {
+        // A frame line with parameters shifts every later payload off the arithmetic index
+        const std::streamoff frameLineSize = (std::streamoff)Y4mHeader::FRAME_MAGIC.size() + 1;
+        const std::streamoff frameLineOffset = frameOffsets_[frameIdx_] - frameLineSize;
+        if (!hasBareFrameLine(ifs_, frameLineOffset, line_)) {
+            try {
+                auto hopRes = hopFrameOffsets(ifs_, dataBegin_, fileSize_, getExtent().getTotalByteSize(), line_,
+                                              frameOffsets_);
+                if (!hopRes) [[unlikely]] {
+                    return std::unexpected{std::move(hopRes.error())};
+                }
+            } catch (const std::bad_alloc&) {
+                return std::unexpected{Error{ECate::eSys, ECode::eOutOfMemory}};
+            }
+            indexVerified_ = true;
+
+            if (frameIdx_ >= getFrameCount()) [[unlikely]] {
+                auto errMsg =
+                    std::format("failed to read, frameIdx={} exceeds frame count {}", frameIdx_, getFrameCount());
+                return std::unexpected{Error{ECate::eTLCT, ECode::eResourceInvalid, std::move(errMsg)}};
+            }
+        }
+    }
+
+    ifs_.clear();
+    ifs_.seekg(frameOffsets_[frameIdx_]);
+
+    ifs_.read((char*)frame.getY().data, frame.getExtent().getYByteSize());
+    if (!ifs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to read");
+        return std::unexpected{Error{ECate::eSys, ifs_.rdstate(), std::move(errMsg)}};
+    }
+
+    ifs_.read((char*)frame.getU().data, frame.getExtent().getUByteSize());
+    if (!ifs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to read");
+        return std::unexpected{Error{ECate::eSys, ifs_.rdstate(), std::move(errMsg)}};
+    }
+
+    ifs_.read((char*)frame.getV().data, frame.getExtent().getVByteSize());
+    if (!ifs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to read");
+        return std::unexpected{Error{ECate::eSys, ifs_.rdstate(), std::move(errMsg)}};
+    }
+
+    frameIdx_++;
+
+    return {};
+}
+
+}  // namespace tlct::_io
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/y4m/header.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io {
+
+namespace fs = std::filesystem;
+
+// Reads a YUV4MPEG2 file. The offset of every frame payload is indexed on open,
+// so `seek` and `skip` are O(1) and never touch the skipped frames.
+// An arithmetic index is verified lazily against the frame line of each frame read. On a mismatch the index is
+// rebuilt by hopping over every frame line, and `getFrameCount()` may change afterwards.
+class Y4mReader {
+    Y4mReader(std::ifstream&& ifs, const Y4mHeader& header, std::string&& line,
+              std::vector<std::streamoff>&& frameOffsets, bool indexVerified, std::streamoff dataBegin,
+              std::streamoff fileSize) noexcept;
+
+public:
+    // Initialize from
+    [[nodiscard]] TLCT_API static std::expected<Y4mReader, Error> create(const fs::path& fpath) noexcept;
+
+    // Const methods
+    [[nodiscard]] TLCT_API const Y4mHeader& getHeader() const noexcept { return header_; }
+    [[nodiscard]] TLCT_API const YuvPlanarExtent& getExtent() const noexcept { return header_.getExtent(); }
+    [[nodiscard]] TLCT_API int getFrameCount() const noexcept { return (int)frameOffsets_.size(); }
+    [[nodiscard]] TLCT_API int getFrameIdx() const noexcept { return frameIdx_; }
+
+    // Non-const methods
+    // Position at the absolute frame index `frameIdx`, `getFrameCount()` is allowed as the end position
+    [[nodiscard]] TLCT_API std::expected<void, Error> seek(int frameIdx) noexcept;
+    [[nodiscard]] TLCT_API std::expected<void, Error> skip(int frameCount) noexcept;
+    [[nodiscard]] TLCT_API std::expected<YuvPlanarFrame, Error> read() noexcept;
+    [[nodiscard]] TLCT_API std::expected<void, Error> readInto(YuvPlanarFrame& frame) noexcept;
+
+private:
+    std::ifstream ifs_;
+    Y4mHeader header_;
+    std::string line_;
+    std::vector<std::streamoff> frameOffsets_;
+    bool indexVerified_;
+    std::streamoff dataBegin_;
+    std::streamoff fileSize_;
+    int frameIdx_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/reader.cpp"
+#endif
@@ -0,0 +1,89 @@
+#include <format>
+#include <ios>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/common/stdio.hpp"
+#include "tlct/io/y4m/header.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/writer.hpp"
+#endif
+
+namespace tlct::_io {
+
+Y4mWriter::Y4mWriter(std::ofstream&& ofs) noexcept : ofs_(std::move(ofs)) {}
+
+std::expected<Y4mWriter, Error> Y4mWriter::create(const fs::path& fpath, const Y4mHeader& header) noexcept {
+    fs::path openPath = fpath;
+    std::ios::openmode mode = std::ios::binary;
+    if (isStdioPath(fpath)) {
+        auto stdoutPathRes = getStdoutPath();
+        if (!stdoutPathRes) [[unlikely]] {
+            return std::unexpected{std::move(stdoutPathRes.error())};
+        }
+        openPath = std::move(stdoutPathRes.value());
+        // Never truncate whatever stdout is redirected to
+        mode |= std::ios::app;
+    }
+
+    std::ofstream ofs{openPath, mode};
+    if (!ofs.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to open write-only file. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
+    }
+
+    ofs << header.toLine();
+    if (!ofs.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write y4m header. path={}", fpath.string());
+        return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
+    }
+
+    return Y4mWriter{std::move(ofs)};
+}
+
+std::expected<void, Error> Y4mWriter::write(const YuvPlanarFrame& frame) noexcept {
+    const auto& extent = frame.getExtent();
+    const char* yptr = (const char*)frame.getY().data;
+    const char* uptr = (const char*)frame.getU().data;
+    const char* vptr = (const char*)frame.getV().data;
+
+    ofs_.write(Y4mHeader::FRAME_MAGIC.data(), (std::streamsize)Y4mHeader::FRAME_MAGIC.size());
+    ofs_.put('\n');
+    if (!ofs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write");
+        return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+    }
+
+    if (yptr + extent.getYByteSize() == uptr && uptr + extent.getUByteSize() == vptr) [[likely]] {
+        ofs_.write(yptr, extent.getTotalByteSize());
+        if (!ofs_.good()) [[unlikely]] {
+            auto errMsg = std::format("failed to write");
+            return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+        }
+        return {};
+    }
+
+    ofs_.write(yptr, extent.getYByteSize());
+    if (!ofs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write");
+        return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+    }
+
+    ofs_.write(uptr, extent.getUByteSize());
+    if (!ofs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write");
+        return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+    }
+
+    ofs_.write(vptr, extent.getVByteSize());
+    if (!ofs_.good()) [[unlikely]] {
+        auto errMsg = std::format("failed to write");
+        return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+    }
+
+    return {};
+}
+
+}  // namespace tlct::_io
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/y4m/header.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io {
+
+namespace fs = std::filesystem;
+
+class Y4mWriter {
+    Y4mWriter(std::ofstream&& ofs) noexcept;
+
+public:
+    // Initialize from
+    // The stream header is written right away. `fpath` may be `-` for stdout.
+    [[nodiscard]] TLCT_API static std::expected<Y4mWriter, Error> create(const fs::path& fpath,
+                                                                         const Y4mHeader& header) noexcept;
+
+    // Non-const methods
+    [[nodiscard]] TLCT_API std::expected<void, Error> write(const YuvPlanarFrame& frame) noexcept;
+
+private:
+    std::ofstream ofs_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/y4m/writer.cpp"
+#endif
@@ -2,6 +2,7 @@
 
 #include "tlct/io/yuv/planar/extent.hpp"
 #include "tlct/io/yuv/planar/frame.hpp"
+#include "tlct/io/yuv/planar/mmap_reader.hpp"
 #include "tlct/io/yuv/planar/reader.hpp"
 #include "tlct/io/yuv/planar/writer.hpp"
 
@@ -11,6 +12,7 @@ namespace _ = _io;
 
 using _io::YuvPlanarExtent;
 using _io::YuvPlanarFrame;
+using _io::YuvPlanarMmapReader;
 using _io::YuvPlanarReader;
 using _io::YuvPlanarWriter;
 
@@ -10,8 +10,15 @@
 
 namespace tlct::_io {
 
-YuvPlanarExtent::YuvPlanarExtent(int yWidth, int yHeight, int depth, int uShift, int vShift, int ySize) noexcept
-    : yWidth_(yWidth), yHeight_(yHeight), depth_(depth), uShift_(uShift), vShift_(vShift), yByteSize_(ySize) {}
+YuvPlanarExtent::YuvPlanarExtent(int yWidth, int yHeight, int depth, int bitDepth, int uShift, int vShift,
+                                 int ySize) noexcept
+    : yWidth_(yWidth),
+      yHeight_(yHeight),
+      depth_(depth),
+      bitDepth_(bitDepth),
+      uShift_(uShift),
+      vShift_(vShift),
+      yByteSize_(ySize) {}
 
 std::expected<YuvPlanarExtent, Error> YuvPlanarExtent::create(int yWidth, int yHeight, int depth, int uShift,
                                                               int vShift) noexcept {
@@ -26,10 +33,33 @@ std::expected<YuvPlanarExtent, Error> YuvPlanarExtent::create(int yWidth, int yH
     }
 
     const int ySize = yWidth * yHeight * depth;
-    return YuvPlanarExtent{yWidth, yHeight, depth, uShift, vShift, ySize};
+    return YuvPlanarExtent{yWidth, yHeight, depth, depth * 8, uShift, vShift, ySize};
 }
+
 std::expected<YuvPlanarExtent, Error> YuvPlanarExtent::createYuv420p8bit(int yWidth, int yHeight) noexcept {
     return create(yWidth, yHeight, 1, 1, 1);
 }
 
+std::expected<YuvPlanarExtent, Error> YuvPlanarExtent::createWithBitDepth(int yWidth, int yHeight, int bitDepth,
+                                                                          int uShift, int vShift) noexcept {
+    if (bitDepth < 8 || bitDepth > 16) [[unlikely]] {
+        auto errMsg = std::format("expect 8 <= bitDepth <= 16, got: {}", bitDepth);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    const int depth = bitDepth > 8 ? 2 : 1;
+    auto extentRes = create(yWidth, yHeight, depth, uShift, vShift);
+    if (!extentRes) [[unlikely]] {
+        return extentRes;
+    }
+    auto& extent = extentRes.value();
+    extent.bitDepth_ = bitDepth;
+
+    return extent;
+}
+
+std::expected<YuvPlanarExtent, Error> YuvPlanarExtent::createYuv420p(int yWidth, int yHeight, int bitDepth) noexcept {
+    return createWithBitDepth(yWidth, yHeight, bitDepth, 1, 1);
+}
+
 }  // namespace tlct::_io
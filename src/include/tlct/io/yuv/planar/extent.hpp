@@ -8,13 +8,19 @@
 namespace tlct::_io {
 
 class YuvPlanarExtent {
-    YuvPlanarExtent(int yWidth, int yHeight, int depth, int uShift, int vShift, int ySize) noexcept;
+    YuvPlanarExtent(int yWidth, int yHeight, int depth, int bitDepth, int uShift, int vShift, int ySize) noexcept;
 
 public:
     [[nodiscard]] TLCT_API static std::expected<YuvPlanarExtent, Error> create(int yWidth, int yHeight, int depth,
                                                                                int uShift, int vShift) noexcept;
+    // Samples with `bitDepth` > 8 are stored LSB-aligned in 16bit words, e.g. yuv420p10le
+    [[nodiscard]] TLCT_API static std::expected<YuvPlanarExtent, Error> createWithBitDepth(int yWidth, int yHeight,
+                                                                                           int bitDepth, int uShift,
+                                                                                           int vShift) noexcept;
     [[nodiscard]] TLCT_API static std::expected<YuvPlanarExtent, Error> createYuv420p8bit(int yWidth,
                                                                                           int yHeight) noexcept;
+    [[nodiscard]] TLCT_API static std::expected<YuvPlanarExtent, Error> createYuv420p(int yWidth, int yHeight,
+                                                                                      int bitDepth) noexcept;
 
     [[nodiscard]] TLCT_API int getYWidth() const noexcept { return yWidth_; }
     [[nodiscard]] TLCT_API int getYHeight() const noexcept { return yHeight_; }
@@ -29,6 +35,7 @@ public:
     [[nodiscard]] TLCT_API cv::Size getVSize() const noexcept { return {getVWidth(), getVHeight()}; }
     [[nodiscard]] TLCT_API int getVByteSize() const noexcept { return yByteSize_ >> (vShift_ << 1); }
     [[nodiscard]] TLCT_API int getDepth() const noexcept { return depth_; }
+    [[nodiscard]] TLCT_API int getBitDepth() const noexcept { return bitDepth_; }
     [[nodiscard]] TLCT_API int getUShift() const noexcept { return uShift_; }
     [[nodiscard]] TLCT_API int getVShift() const noexcept { return vShift_; }
     [[nodiscard]] TLCT_API int getTotalByteSize() const noexcept {
@@ -40,6 +47,7 @@ private:
     int yWidth_;
     int yHeight_;
     int depth_;
+    int bitDepth_;
     int uShift_;
     int vShift_;
     int yByteSize_;
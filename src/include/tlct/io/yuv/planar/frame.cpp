@@ -18,21 +18,26 @@ YuvPlanarFrame::YuvPlanarFrame(const YuvPlanarExtent& extent, std::unique_ptr<st
                                cv::Mat&& u, cv::Mat&& v) noexcept
     : extent_(extent), pBuffer_(std::move(pBuffer)), y_(std::move(y)), u_(std::move(u)), v_(std::move(v)) {}
 
-std::expected<YuvPlanarFrame, Error> YuvPlanarFrame::create(const YuvPlanarExtent& extent) noexcept {
-    int cvTp;
+inline std::expected<int, Error> depthToCvType(const YuvPlanarExtent& extent) noexcept {
     switch (extent.getDepth()) {
         case 1:
-            cvTp = CV_8U;
-            break;
+            return CV_8U;
         case 2:
-            cvTp = CV_16U;
-            break;
+            return CV_16U;
         default:
             [[unlikely]] {
                 auto errMsg = std::format("expect depth 1(8bit) or 2(16bit), got {}", extent.getDepth());
                 return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
             }
     }
+}
+
+std::expected<YuvPlanarFrame, Error> YuvPlanarFrame::create(const YuvPlanarExtent& extent) noexcept {
+    const auto cvTpRes = depthToCvType(extent);
+    if (!cvTpRes) [[unlikely]] {
+        return std::unexpected{std::move(cvTpRes.error())};
+    }
+    const int cvTp = cvTpRes.value();
 
     const size_t alignedYSize = _hp::alignUp<SIMD_FETCH_SIZE>(extent.getYByteSize());
     const size_t alignedUSize = _hp::alignUp<SIMD_FETCH_SIZE>(extent.getUByteSize());
@@ -57,4 +62,23 @@ std::expected<YuvPlanarFrame, Error> YuvPlanarFrame::create(const YuvPlanarExten
     return YuvPlanarFrame{extent, std::move(pBuffer), std::move(y), std::move(u), std::move(v)};
 }
 
+std::expected<YuvPlanarFrame, Error> YuvPlanarFrame::createView(const YuvPlanarExtent& extent,
+                                                                const std::byte* pSrc) noexcept {
+    const auto cvTpRes = depthToCvType(extent);
+    if (!cvTpRes) [[unlikely]] {
+        return std::unexpected{std::move(cvTpRes.error())};
+    }
+    const int cvTp = cvTpRes.value();
+
+    std::byte* yptr = (std::byte*)pSrc;
+    std::byte* uptr = yptr + extent.getYByteSize();
+    std::byte* vptr = uptr + extent.getUByteSize();
+
+    cv::Mat y = cv::Mat(extent.getYHeight(), extent.getYWidth(), cvTp, yptr);
+    cv::Mat u = cv::Mat(extent.getUHeight(), extent.getUWidth(), cvTp, uptr);
+    cv::Mat v = cv::Mat(extent.getVHeight(), extent.getVWidth(), cvTp, vptr);
+
+    return YuvPlanarFrame{extent, nullptr, std::move(y), std::move(u), std::move(v)};
+}
+
 }  // namespace tlct::_io
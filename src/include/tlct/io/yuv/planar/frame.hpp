@@ -24,6 +24,9 @@ public:
     YuvPlanarFrame& operator=(YuvPlanarFrame&& rhs) noexcept = default;
 
     [[nodiscard]] TLCT_API static std::expected<YuvPlanarFrame, Error> create(const YuvPlanarExtent& extent) noexcept;
+    // Non-owning frame over tightly packed Y/U/V planes starting at `pSrc`. The planes must NOT be written.
+    [[nodiscard]] TLCT_API static std::expected<YuvPlanarFrame, Error> createView(const YuvPlanarExtent& extent,
+                                                                                  const std::byte* pSrc) noexcept;
 
     [[nodiscard]] TLCT_API const YuvPlanarExtent& getExtent() const noexcept { return extent_; }
     [[nodiscard]] TLCT_API const cv::Mat& getY() const noexcept { return y_; }
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <format>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/mmap.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+#ifndef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/yuv/planar/mmap_reader.hpp"
+#endif
+
+namespace tlct::_io {
+
+YuvPlanarMmapReader::YuvPlanarMmapReader(_hp::MmapFile&& file, const YuvPlanarExtent& extent) noexcept
+    : file_(std::move(file)), extent_(extent), offset_(0) {}
+
+std::expected<YuvPlanarMmapReader, Error> YuvPlanarMmapReader::create(const fs::path& fpath,
+                                                                      const YuvPlanarExtent& extent) noexcept {
+    auto fileRes = _hp::MmapFile::createReadOnly(fpath);
+    if (!fileRes) [[unlikely]] {
+        return std::unexpected{std::move(fileRes.error())};
+    }
+    auto& file = fileRes.value();
+
+    file.adviseSequential();
+    file.adviseWillNeed(0, extent.getTotalByteSize());
+
+    return YuvPlanarMmapReader{std::move(file), extent};
+}
+
+size_t YuvPlanarMmapReader::getFrameCount() const noexcept {
+    return file_.getSize() / (size_t)extent_.getTotalByteSize();
+}
+
+std::expected<void, Error> YuvPlanarMmapReader::skip(int frameCount) noexcept {
+    const size_t offset = offset_ + (size_t)frameCount * extent_.getTotalByteSize();
+    if (frameCount < 0 || offset > file_.getSize()) [[unlikely]] {
+        auto errMsg = std::format("failed to skip {} frames, the file only has {}", frameCount, getFrameCount());
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
+
+    offset_ = offset;
+    file_.adviseWillNeed(offset_, extent_.getTotalByteSize());
+
+    return {};
+}
+
+std::expected<const std::byte*, Error> YuvPlanarMmapReader::advance() noexcept {
+    const size_t frameSize = extent_.getTotalByteSize();
+    if (offset_ + frameSize > file_.getSize()) [[unlikely]] {
+        auto errMsg = std::format("failed to read, offset={} exceeds file size {}", offset_, file_.getSize());
+        return std::unexpected{Error{ECate::eSys, ECode::eResourceInvalid, std::move(errMsg)}};
+    }
+
+    const std::byte* pFrame = file_.getData() + offset_;
+    offset_ += frameSize;
+
+    // Keep exactly one frame of readahead in flight
+    file_.adviseWillNeed(offset_, frameSize);
+
+    return pFrame;
+}
+
+std::expected<YuvPlanarFrame, Error> YuvPlanarMmapReader::read() noexcept {
+    auto pFrameRes = advance();
+    if (!pFrameRes) [[unlikely]] {
+        return std::unexpected{std::move(pFrameRes.error())};
+    }
+
+    return YuvPlanarFrame::createView(extent_, pFrameRes.value());
+}
+
+std::expected<void, Error> YuvPlanarMmapReader::readInto(YuvPlanarFrame& frame) noexcept {
+    auto pFrameRes = advance();
+    if (!pFrameRes) [[unlikely]] {
+        return std::unexpected{std::move(pFrameRes.error())};
+    }
+    const std::byte* pFrame = pFrameRes.value();
+
+    const auto& extent = frame.getExtent();
+    std::memcpy(frame.getY().data, pFrame, extent.getYByteSize());
+    pFrame += extent.getYByteSize();
+    std::memcpy(frame.getU().data, pFrame, extent.getUByteSize());
+    pFrame += extent.getUByteSize();
+    std::memcpy(frame.getV().data, pFrame, extent.getVByteSize());
+
+    return {};
+}
+
+}  // namespace tlct::_io
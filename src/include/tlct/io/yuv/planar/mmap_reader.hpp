@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+
+#include "tlct/helper/error.hpp"
+#include "tlct/helper/mmap.hpp"
+#include "tlct/helper/std.hpp"
+#include "tlct/io/yuv/planar/extent.hpp"
+#include "tlct/io/yuv/planar/frame.hpp"
+
+namespace tlct::_io {
+
+namespace fs = std::filesystem;
+
+// Reader backed by a read-only mapping of the whole file.
+// Frames given out by `read()` are views into the mapping and remain valid as long as the reader is alive.
+class YuvPlanarMmapReader {
+    YuvPlanarMmapReader(_hp::MmapFile&& file, const YuvPlanarExtent& extent) noexcept;
+
+public:
+    [[nodiscard]] TLCT_API static std::expected<YuvPlanarMmapReader, Error> create(
+        const fs::path& fpath, const YuvPlanarExtent& extent) noexcept;
+
+    [[nodiscard]] TLCT_API size_t getFrameCount() const noexcept;
+
+    [[nodiscard]] TLCT_API std::expected<void, Error> skip(int frameCount) noexcept;
+    [[nodiscard]] TLCT_API std::expected<YuvPlanarFrame, Error> read() noexcept;
+    [[nodiscard]] TLCT_API std::expected<void, Error> readInto(YuvPlanarFrame& frame) noexcept;
+
+private:
+    [[nodiscard]] std::expected<const std::byte*, Error> advance() noexcept;
+
+    _hp::MmapFile file_;
+    YuvPlanarExtent extent_;
+    size_t offset_;
+};
+
+}  // namespace tlct::_io
+
+#ifdef _TLCT_LIB_HEADER_ONLY
+#    include "tlct/io/yuv/planar/mmap_reader.cpp"
+#endif
@@ -3,6 +3,7 @@
 
 #include "tlct/helper/error.hpp"
 #include "tlct/helper/std.hpp"
+#include "tlct/io/common/stdio.hpp"
 #include "tlct/io/yuv/planar/extent.hpp"
 #include "tlct/io/yuv/planar/frame.hpp"
 
@@ -12,22 +13,43 @@
 
 namespace tlct::_io {
 
-YuvPlanarReader::YuvPlanarReader(std::ifstream&& ifs, const YuvPlanarExtent& extent) noexcept
-    : ifs_(std::move(ifs)), extent_(extent) {}
+YuvPlanarReader::YuvPlanarReader(std::ifstream&& ifs, const YuvPlanarExtent& extent, bool seekable) noexcept
+    : ifs_(std::move(ifs)), extent_(extent), seekable_(seekable) {}
 
 std::expected<YuvPlanarReader, Error> YuvPlanarReader::create(const fs::path& fpath,
                                                               const YuvPlanarExtent& extent) noexcept {
-    std::ifstream ifs{fpath, std::ios::binary};
+    fs::path openPath = fpath;
+    if (isStdioPath(fpath)) {
+        auto stdinPathRes = getStdinPath();
+        if (!stdinPathRes) [[unlikely]] {
+            return std::unexpected{std::move(stdinPathRes.error())};
+        }
+        openPath = std::move(stdinPathRes.value());
+    }
+
+    std::ifstream ifs{openPath, std::ios::binary};
     if (!ifs.good()) [[unlikely]] {
         auto errMsg = std::format("failed to open read-only file. path={}", fpath.string());
         return std::unexpected{Error{ECate::eSys, ifs.rdstate(), std::move(errMsg)}};
     }
 
-    return YuvPlanarReader{std::move(ifs), extent};
+    // Pipes reject seeking, which `tellg` reports as -1
+    const bool seekable = ifs.tellg() != std::streampos(-1);
+    ifs.clear();
+
+    return YuvPlanarReader{std::move(ifs), extent, seekable};
 }
 
 std::expected<void, Error> YuvPlanarReader::skip(int frameCount) noexcept {
-    ifs_.seekg(frameCount * extent_.getTotalByteSize());
+    const std::streamoff skipSize = (std::streamoff)frameCount * extent_.getTotalByteSize();
+    if (seekable_) {
+        ifs_.seekg(skipSize, std::ios::cur);
+    } else if (frameCount >= 0) {
+        ifs_.ignore(skipSize);
+    } else [[unlikely]] {
+        auto errMsg = std::format("cannot skip backwards {} frames on a non-seekable stream", -frameCount);
+        return std::unexpected{Error{ECate::eTLCT, ECode::eUnexValue, std::move(errMsg)}};
+    }
 
     if (!ifs_.good()) [[unlikely]] {
         auto errMsg = std::format("failed to skip {} frames", frameCount);
@@ -13,9 +13,10 @@ namespace tlct::_io {
 namespace fs = std::filesystem;
 
 class YuvPlanarReader {
-    YuvPlanarReader(std::ifstream&& ifs, const YuvPlanarExtent& extent) noexcept;
+    YuvPlanarReader(std::ifstream&& ifs, const YuvPlanarExtent& extent, bool seekable) noexcept;
 
 public:
+    // `fpath` may be `-` for stdin. Pipes and FIFOs are read sequentially, `skip` then discards the frames.
     [[nodiscard]] TLCT_API static std::expected<YuvPlanarReader, Error> create(const fs::path& fpath,
                                                                                const YuvPlanarExtent& extent) noexcept;
 
@@ -26,6 +27,7 @@ public:
 private:
     std::ifstream ifs_;
     YuvPlanarExtent extent_;
+    bool seekable_;
 };
 
 }  // namespace tlct::_io
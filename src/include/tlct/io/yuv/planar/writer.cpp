@@ -2,6 +2,7 @@
 #include <ios>
 
 #include "tlct/helper/std.hpp"
+#include "tlct/io/common/stdio.hpp"
 #include "tlct/io/yuv/planar/frame.hpp"
 
 #ifndef _TLCT_LIB_HEADER_ONLY
@@ -13,7 +14,19 @@ namespace tlct::_io {
 YuvPlanarWriter::YuvPlanarWriter(std::ofstream&& ofs) noexcept : ofs_(std::move(ofs)) {}
 
 std::expected<YuvPlanarWriter, Error> YuvPlanarWriter::create(const fs::path& fpath) noexcept {
-    std::ofstream ofs{fpath, std::ios::binary};
+    fs::path openPath = fpath;
+    std::ios::openmode mode = std::ios::binary;
+    if (isStdioPath(fpath)) {
+        auto stdoutPathRes = getStdoutPath();
+        if (!stdoutPathRes) [[unlikely]] {
+            return std::unexpected{std::move(stdoutPathRes.error())};
+        }
+        openPath = std::move(stdoutPathRes.value());
+        // Never truncate whatever stdout is redirected to
+        mode |= std::ios::app;
+    }
+
+    std::ofstream ofs{openPath, mode};
     if (!ofs.good()) [[unlikely]] {
         auto errMsg = std::format("failed to open read-only file. path={}", fpath.string());
         return std::unexpected{Error{ECate::eSys, ofs.rdstate(), std::move(errMsg)}};
@@ -21,20 +34,36 @@ std::expected<YuvPlanarWriter, Error> YuvPlanarWriter::create(const fs::path& fp
     return YuvPlanarWriter{std::move(ofs)};
 }
 
-std::expected<void, Error> YuvPlanarWriter::write(YuvPlanarFrame& frame) noexcept {
-    ofs_.write((char*)frame.getY().data, frame.getExtent().getYByteSize());
+std::expected<void, Error> YuvPlanarWriter::write(const YuvPlanarFrame& frame) noexcept {
+    const auto& extent = frame.getExtent();
+    const char* yptr = (const char*)frame.getY().data;
+    const char* uptr = (const char*)frame.getU().data;
+    const char* vptr = (const char*)frame.getV().data;
+
+    // Coalesce the planes into one write when they are laid out back-to-back,
+    // which is the case whenever the plane sizes are multiples of `SIMD_FETCH_SIZE`
+    if (yptr + extent.getYByteSize() == uptr && uptr + extent.getUByteSize() == vptr) [[likely]] {
+        ofs_.write(yptr, extent.getTotalByteSize());
+        if (!ofs_.good()) [[unlikely]] {
+            auto errMsg = std::format("failed to write");
+            return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
+        }
+        return {};
+    }
+
+    ofs_.write(yptr, extent.getYByteSize());
     if (!ofs_.good()) [[unlikely]] {
         auto errMsg = std::format("failed to write");
         return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
     }
 
-    ofs_.write((char*)frame.getU().data, frame.getExtent().getUByteSize());
+    ofs_.write(uptr, extent.getUByteSize());
     if (!ofs_.good()) [[unlikely]] {
         auto errMsg = std::format("failed to write");
         return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
     }
 
-    ofs_.write((char*)frame.getV().data, frame.getExtent().getVByteSize());
+    ofs_.write(vptr, extent.getVByteSize());
     if (!ofs_.good()) [[unlikely]] {
         auto errMsg = std::format("failed to write");
         return std::unexpected{Error{ECate::eSys, ofs_.rdstate(), std::move(errMsg)}};
@@ -15,9 +15,10 @@ class YuvPlanarWriter {
     TLCT_API YuvPlanarWriter(std::ofstream&& ofs) noexcept;
 
 public:
+    // `fpath` may be `-` for stdout
     [[nodiscard]] TLCT_API static std::expected<YuvPlanarWriter, Error> create(const fs::path& fpath) noexcept;
 
-    [[nodiscard]] TLCT_API std::expected<void, Error> write(YuvPlanarFrame& frame) noexcept;
+    [[nodiscard]] TLCT_API std::expected<void, Error> write(const YuvPlanarFrame& frame) noexcept;
 
 private:
     std::ofstream ofs_;
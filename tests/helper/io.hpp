@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <opencv2/core.hpp>
+
+#include "tlct.hpp"
+
+// Every sample of frame `frameIdx` is `frameIdx + 1`, so a misplaced payload never matches
+
+inline void appendFrame(std::string& content, const tlct::_io::YuvPlanarExtent& extent, int frameIdx) {
+    const int sampleCount = extent.getTotalByteSize() / extent.getDepth();
+    const uint16_t sample = (uint16_t)(frameIdx + 1);
+    for (int i = 0; i < sampleCount; i++) {
+        content += (char)(sample & 0xff);
+        if (extent.getDepth() == 2) content += (char)(sample >> 8);
+    }
+}
+
+inline std::string makeYuv(const tlct::_io::YuvPlanarExtent& extent, int frameCount) {
+    std::string content;
+    for (int frameIdx = 0; frameIdx < frameCount; frameIdx++) {
+        appendFrame(content, extent, frameIdx);
+    }
+    return content;
+}
+
+inline void fillFrame(tlct::_io::YuvPlanarFrame& frame, int frameIdx) {
+    const cv::Scalar value = cv::Scalar::all(frameIdx + 1);
+    frame.getY().setTo(value);
+    frame.getU().setTo(value);
+    frame.getV().setTo(value);
+}
+
+inline bool isFilledWith(const cv::Mat& plane, int value) {
+    cv::Mat diff;
+    cv::compare(plane, cv::Scalar::all(value), diff, cv::CMP_NE);
+    return cv::countNonZero(diff) == 0;
+}
+
+inline bool isFrameOf(const tlct::_io::YuvPlanarFrame& frame, int frameIdx) {
+    const int value = frameIdx + 1;
+    return isFilledWith(frame.getY(), value) && isFilledWith(frame.getU(), value) &&
+           isFilledWith(frame.getV(), value);
+}
+
+inline std::filesystem::path writeTemp(std::string_view name, const std::string& content) {
+    const std::filesystem::path fpath = std::filesystem::temp_directory_path() / name;
+    std::ofstream ofs{fpath, std::ios::binary};
+    ofs.write(content.data(), (std::streamsize)content.size());
+    return fpath;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+// Shared by the tests comparing the kernels against their OpenCV counterparts
+
+inline double maxAbsDiff(const cv::Mat& lhs, const cv::Mat& rhs) {
+    cv::Mat diff;
+    cv::absdiff(lhs, rhs, diff);
+    double maxDiff;
+    cv::minMaxLoc(diff.reshape(1), nullptr, &maxDiff);
+    return maxDiff;
+}
+
+// Uniform samples in [0, high)
+inline cv::Mat randomPlane(cv::Size size, int type, double high) {
+    cv::Mat plane{size, type};
+    cv::randu(plane, 0, high);
+    return plane;
+}
@@ -0,0 +1,131 @@
+#include <filesystem>
+#include <format>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tlct.hpp"
+
+#include "helper/io.hpp"
+
+namespace fs = std::filesystem;
+namespace _io = tlct::_io;
+
+using TAsyncWriter = _io::AsyncWriter_<_io::YuvPlanarWriter>;
+
+TEST_CASE("Frames are written in order per writer", "tlct::_io#AsyncWriter") {
+    constexpr int WRITER_NUM = 2;
+    constexpr int FRAME_COUNT = 6;
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+
+    std::vector<fs::path> fpaths;
+    std::vector<_io::YuvPlanarWriter> writers;
+    for (const int writerIdx : {0, 1}) {
+        fpaths.push_back(fs::temp_directory_path() / std::format("tlct_test_async_order_{}.yuv", writerIdx));
+        writers.push_back(_io::YuvPlanarWriter::create(fpaths.back()).value());
+    }
+
+    {
+        // Fewer slots than frames, so the queue wraps around and `write` blocks on it
+        auto asyncWriter = TAsyncWriter::create(std::move(writers), extent, 2).value();
+        auto frame = _io::YuvPlanarFrame::create(extent).value();
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+            // `frame` receives a recycled buffer after each write
+            fillFrame(frame, frameIdx);
+            REQUIRE(asyncWriter.write(frameIdx % WRITER_NUM, frame).has_value());
+        }
+        REQUIRE(asyncWriter.flush().has_value());
+        REQUIRE(!asyncWriter.write(WRITER_NUM, frame).has_value());
+    }
+
+    for (const int writerIdx : {0, 1}) {
+        {
+            auto reader = _io::YuvPlanarMmapReader::create(fpaths[writerIdx], extent).value();
+            REQUIRE(reader.getFrameCount() == FRAME_COUNT / WRITER_NUM);
+            for (int frameIdx = writerIdx; frameIdx < FRAME_COUNT; frameIdx += WRITER_NUM) {
+                REQUIRE(isFrameOf(reader.read().value(), frameIdx));
+            }
+        }
+        fs::remove(fpaths[writerIdx]);
+    }
+}
+
+TEST_CASE("Mosaic frames are queued and written whole", "tlct::_io#AsyncWriter") {
+    constexpr int VIEWS = 2;
+    constexpr int FRAME_COUNT = 3;
+    const auto tileExtent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    const auto mosaicExtent = _io::YuvPlanarExtent::createYuv420p(VIEWS * tileExtent.getYWidth(),
+                                                                  VIEWS * tileExtent.getYHeight(), 8)
+                                  .value();
+    const fs::path fpath = fs::temp_directory_path() / "tlct_test_async_mosaic.yuv";
+
+    // Tile `view` of frame `frameIdx` holds `frameIdx * VIEWS * VIEWS + view + 1` in all planes
+    const auto getTileRoi = [](const cv::Size tileSize, const int view) {
+        return cv::Rect{view % VIEWS * tileSize.width, view / VIEWS * tileSize.height, tileSize.width,
+                        tileSize.height};
+    };
+
+    {
+        // The ring takes the mosaic extent, and the single writer gets one frame per source frame
+        std::vector<_io::YuvPlanarWriter> writers;
+        writers.push_back(_io::YuvPlanarWriter::create(fpath).value());
+        auto asyncWriter = TAsyncWriter::create(std::move(writers), mosaicExtent, 2).value();
+
+        auto mosaic = _io::YuvPlanarFrame::create(mosaicExtent).value();
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+            for (int view = 0; view < VIEWS * VIEWS; view++) {
+                const cv::Scalar value = cv::Scalar::all(frameIdx * VIEWS * VIEWS + view + 1);
+                mosaic.getY()(getTileRoi(tileExtent.getYSize(), view)).setTo(value);
+                mosaic.getU()(getTileRoi(tileExtent.getUSize(), view)).setTo(value);
+                mosaic.getV()(getTileRoi(tileExtent.getVSize(), view)).setTo(value);
+            }
+            REQUIRE(asyncWriter.write(0, mosaic).has_value());
+        }
+        REQUIRE(asyncWriter.flush().has_value());
+    }
+
+    {
+        auto reader = _io::YuvPlanarMmapReader::create(fpath, mosaicExtent).value();
+        REQUIRE(reader.getFrameCount() == FRAME_COUNT);
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+            const auto mosaic = reader.read().value();
+            for (int view = 0; view < VIEWS * VIEWS; view++) {
+                const int value = frameIdx * VIEWS * VIEWS + view + 1;
+                REQUIRE(isFilledWith(mosaic.getY()(getTileRoi(tileExtent.getYSize(), view)), value));
+                REQUIRE(isFilledWith(mosaic.getU()(getTileRoi(tileExtent.getUSize(), view)), value));
+                REQUIRE(isFilledWith(mosaic.getV()(getTileRoi(tileExtent.getVSize(), view)), value));
+            }
+        }
+    }
+
+    fs::remove(fpath);
+}
+
+#ifdef __linux__
+
+TEST_CASE("Write errors are sticky", "tlct::_io#AsyncWriter") {
+    // Larger than the stream buffer, so each write reaches the device at once
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(256, 256).value();
+    const fs::path fpath = fs::temp_directory_path() / "tlct_test_async_sticky.yuv";
+
+    std::vector<_io::YuvPlanarWriter> writers;
+    writers.push_back(_io::YuvPlanarWriter::create(fpath).value());
+    writers.push_back(_io::YuvPlanarWriter::create("/dev/full").value());
+
+    {
+        auto asyncWriter = TAsyncWriter::create(std::move(writers), extent, 2).value();
+        auto frame = _io::YuvPlanarFrame::create(extent).value();
+        fillFrame(frame, 0);
+        REQUIRE(asyncWriter.write(1, frame).has_value());
+
+        // Reported by every later call, whatever writer it targets
+        REQUIRE(!asyncWriter.flush().has_value());
+        REQUIRE(!asyncWriter.write(0, frame).has_value());
+        REQUIRE(!asyncWriter.flush().has_value());
+    }
+
+    fs::remove(fpath);
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tlct.hpp"
+
+#ifndef TLCT_TESTDATA_DIR
+#    define TLCT_TESTDATA_DIR "."
+#endif
+
+namespace fs = std::filesystem;
+namespace _cvt = tlct::_cvt;
+
+using TBridge = _cvt::PatchMergeBridge_<tlct::cfg::OffsetArrange>;
+using TWriter = _cvt::BridgeFileWriter_<TBridge>;
+using TReader = _cvt::BridgeFileReader_<TBridge>;
+
+// What the container is able to reproduce
+static float quantize(float v, int fracBits) { return _cvt::fromFixedPoint(_cvt::toFixedPoint(v, fracBits), fracBits); }
+
+TEST_CASE("Bridge container round trip", "tlct::_cvt#BridgeFile") {
+    const fs::path testdataDir{TLCT_TESTDATA_DIR};
+    fs::current_path(testdataDir);
+
+    const auto calibCfg = tlct::ConfigMap::createFromPath("test/raytrix.cfg").value();
+    const auto arrange = tlct::cfg::OffsetArrange::createWithCalibCfg(calibCfg).value();
+    REQUIRE(arrange.isMultiFocus());
+
+    constexpr int FRAME_COUNT = 11;
+    constexpr int KEYFRAME_INTERVAL = 4;
+    const fs::path fpath = fs::temp_directory_path() / "tlct_test_bridge.bin";
+
+    // Sparse fids exercise the fid lookup
+    std::vector<int> fids(FRAME_COUNT);
+    std::vector<TBridge> bridges;
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> psizeDist{4.f, 40.f};
+    std::uniform_real_distribution<float> weightDist{0.f, 1.f};
+    for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+        fids[frameIdx] = frameIdx * 3 + 1;
+        auto bridge = TBridge::create(arrange).value();
+        _cvt::forEachMIOffset(arrange, [&](int offset) {
+            bridge.getInfo(offset).setPatchsize(psizeDist(rng));
+            bridge.setWeight(offset, weightDist(rng));
+        });
+        bridges.push_back(std::move(bridge));
+    }
+
+    {
+        auto writer = TWriter::create(fpath, arrange, {}, KEYFRAME_INTERVAL).value();
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+            REQUIRE(writer.write(fids[frameIdx], bridges[frameIdx]).has_value());
+        }
+        REQUIRE(!writer.write(fids[0], bridges[0]).has_value());
+        REQUIRE(writer.finish().has_value());
+    }
+
+    const auto isDecodedAs = [&](const TBridge& decoded, int frameIdx) {
+        bool same = true;
+        _cvt::forEachMIOffset(arrange, [&](int offset) {
+            const auto& expected = bridges[frameIdx];
+            same = same &&
+                   decoded.getPatchsize(offset) ==
+                       quantize(expected.getPatchsize(offset), _cvt::BridgeFileHeader::PSIZE_FRAC_BITS) &&
+                   decoded.getWeight(offset) ==
+                       quantize(expected.getWeight(offset), _cvt::BridgeFileHeader::WEIGHT_FRAC_BITS);
+        });
+        return same;
+    };
+
+    SECTION("Random access") {
+        auto reader = TReader::create(fpath, arrange).value();
+        REQUIRE(reader.getFrameCount() == FRAME_COUNT);
+        REQUIRE(reader.getHeader().keyframeInterval == KEYFRAME_INTERVAL);
+
+        auto decoded = TBridge::create(arrange).value();
+        // Sequential, backwards across keyframes, forwards within a group and repeated reads
+        for (const int frameIdx : {0, 1, 2, 3, 4, 5, 10, 9, 6, 2, 7, 7, 8, 0, 10}) {
+            REQUIRE(reader.readInto(fids[frameIdx], decoded).has_value());
+            REQUIRE(isDecodedAs(decoded, frameIdx));
+        }
+
+        REQUIRE(!reader.readInto(fids[1] + 1, decoded).has_value());
+        REQUIRE(!reader.readInto(fids[FRAME_COUNT - 1] + 3, decoded).has_value());
+    }
+
+    SECTION("Reject a truncated container") {
+        const fs::path truncatedPath = fs::temp_directory_path() / "tlct_test_bridge_truncated.bin";
+        fs::copy_file(fpath, truncatedPath, fs::copy_options::overwrite_existing);
+
+        for (const auto size : {fs::file_size(fpath) - 1, fs::file_size(fpath) / 2, (uintmax_t)16}) {
+            fs::resize_file(truncatedPath, size);
+            const auto readerRes = TReader::create(truncatedPath, arrange);
+            REQUIRE(!readerRes.has_value());
+            REQUIRE(readerRes.error().cate == tlct::ECate::eTLCT);
+        }
+
+        fs::remove(truncatedPath);
+    }
+
+    SECTION("Reject a corrupted index") {
+        const fs::path corruptedPath = fs::temp_directory_path() / "tlct_test_bridge_corrupted.bin";
+        fs::copy_file(fpath, corruptedPath, fs::copy_options::overwrite_existing);
+
+        _cvt::BridgeFileHeader header;
+        {
+            std::ifstream ifs{corruptedPath, std::ios::binary};
+            ifs.read((char*)&header, sizeof(header));
+        }
+
+        // Offsets that wrap around when summed with the size or with the index size
+        const auto corrupt = [&](std::streamoff offset, uint64_t value) {
+            std::fstream file{corruptedPath, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(offset);
+            file.write((const char*)&value, sizeof(value));
+        };
+        constexpr uint64_t WRAPPING_OFFSET = std::numeric_limits<uint64_t>::max() - 4;
+        corrupt((std::streamoff)header.indexOffset, WRAPPING_OFFSET);
+        REQUIRE(!TReader::create(corruptedPath, arrange).has_value());
+        corrupt((std::streamoff)offsetof(_cvt::BridgeFileHeader, indexOffset), WRAPPING_OFFSET);
+        REQUIRE(!TReader::create(corruptedPath, arrange).has_value());
+
+        fs::remove(corruptedPath);
+    }
+
+    SECTION("Reject another geometry") {
+        auto upsampled = arrange;
+        upsampled.upsample(2);
+        const auto readerRes = TReader::create(fpath, upsampled);
+        REQUIRE(!readerRes.has_value());
+        REQUIRE(readerRes.error().cate == tlct::ECate::eTLCT);
+    }
+
+    fs::remove(fpath);
+}
+
+TEST_CASE("Non-finite values are stored as zero", "tlct::_cvt#BridgeFile") {
+    REQUIRE(_cvt::toFixedPoint(std::numeric_limits<float>::quiet_NaN(), 8) == 0);
+    REQUIRE(_cvt::toFixedPoint(std::numeric_limits<float>::infinity(), 8) == 0);
+    REQUIRE(_cvt::toFixedPoint(-std::numeric_limits<float>::infinity(), 8) == 0);
+    REQUIRE(_cvt::toFixedPoint(1.5f, 8) == 384);
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+#include "tlct.hpp"
+
+#ifndef TLCT_TESTDATA_DIR
+#    define TLCT_TESTDATA_DIR "."
+#endif
+
+namespace fs = std::filesystem;
+namespace _cvt = tlct::_cvt;
+namespace _hp = tlct::_hp;
+namespace census = tlct::_cvt::census;
+
+TEST_CASE("Census transform matches the reference", "tlct::_cvt::census#censusTransform5x5") {
+    cv::setRNGSeed(21);
+    std::vector<int16_t> scratch;
+
+    for (const int type : {CV_8UC1, CV_16UC1}) {
+        // Below one vector, exactly one, off the vector lanes and a single row
+        for (const cv::Size size :
+             {cv::Size{3, 4}, cv::Size{7, 9}, cv::Size{16, 5}, cv::Size{37, 11}, cv::Size{21, 1}}) {
+            // Few distinct values, so equal neighbors are common. 16bit samples straddle the sign bit.
+            cv::Mat src{size, type};
+            if (type == CV_8UC1) {
+                cv::randu(src, 0, 4);
+            } else {
+                cv::randu(src, 0x7ffe, 0x8002);
+            }
+            cv::Mat srcMask{size, CV_8UC1};
+            cv::randu(srcMask, 0, 2);
+
+            cv::Mat refMap{size, CV_32SC1};
+            cv::Mat refMask{size, CV_32SC1};
+            census::censusTransform5x5Ref(src, srcMask, refMap, refMask);
+
+            cv::Mat censusMask{size, CV_32SC1};
+            census::censusMask5x5(srcMask, censusMask);
+            REQUIRE(cv::countNonZero(censusMask != refMask) == 0);
+
+            // Map bits are only meaningful under the mask
+            cv::Mat censusMap{size, CV_32SC1};
+            scratch.resize(std::max(scratch.size(), census::censusMap5x5ScratchSize(size)));
+            census::censusMap5x5(src, censusMap, scratch);
+            REQUIRE(cv::countNonZero((censusMap & censusMask) != (refMap & refMask)) == 0);
+
+            cv::Mat censusMapNoScratch{size, CV_32SC1};
+            census::censusMap5x5(src, censusMapNoScratch);
+            REQUIRE(cv::countNonZero(censusMapNoScratch != censusMap) == 0);
+        }
+    }
+}
+
+static census::MIBuffer randomMI(const float censusDiameter) {
+    const int iCensusDiameter = _hp::iround(censusDiameter);
+    cv::Mat censusMap{iCensusDiameter, iCensusDiameter, CV_32SC1};
+    cv::randu(censusMap, INT32_MIN, INT32_MAX);
+    return {std::move(censusMap), 0.f};
+}
+
+// The offsets matched by the psize estimation, the near curves first
+template <typename TNeighbors>
+static void appendMatchOffsets(const typename TNeighbors::TArrange& arrange, const int minPsize, const int maxPsize,
+                               std::vector<cv::Point>& offsets) {
+    for (const auto direction : TNeighbors::DIRECTIONS) {
+        const cv::Point2f matchStep = (float)-_hp::sgn(arrange.isKepler()) * TNeighbors::getUnitShift(direction);
+        for (int psize = minPsize; psize < maxPsize; psize++) {
+            offsets.emplace_back(matchStep * psize);
+        }
+    }
+}
+
+// The overlaps of every match offset, laid out as in the psize estimation
+template <typename TArrange>
+static census::CensusOverlaps makeOverlaps(const TArrange& arrange, const census::PsizeParams_<TArrange>& params,
+                                           const float censusDiameter) {
+    std::vector<cv::Point> offsets;
+    appendMatchOffsets<_cvt::NearNeighbors_<TArrange>>(arrange, params.minPsize, params.maxPsize, offsets);
+    appendMatchOffsets<_cvt::FarNeighbors_<TArrange>>(arrange, params.minPsize, params.maxPsize, offsets);
+    return census::CensusOverlaps::create(censusDiameter, offsets, params.maxPsize - params.minPsize).value();
+}
+
+// The defaults of the CLI
+constexpr tlct::cfg::CliConfig::Convert CVT_CFG{
+    .psizeInflate = 2.15f, .viewShiftRange = 0.1f, .psizeShortcutThreshold = 0.95f, .bitDepth = 8};
+
+// An empty overlap yields NaN on both paths
+static bool isSameMetric(const float lhs, const float rhs) {
+    return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+
+template <typename TArrange>
+static void requireCurvesMatchCompare(const TArrange& arrange) {
+    const auto params = census::PsizeParams_<TArrange>::create(arrange, CVT_CFG).value();
+    const int curveLen = params.maxPsize - params.minPsize;
+    REQUIRE(curveLen > 0);
+
+    const float censusDiameter = census::MIBuffers_<TArrange>::create(arrange, 8).value().getCensusDiameter();
+    const auto overlaps = makeOverlaps(arrange, params, censusDiameter);
+    REQUIRE(overlaps.getCurveLen() == curveLen);
+
+    const census::MIBuffer lhsMI = randomMI(censusDiameter);
+    const census::MIBuffer rhsMI = randomMI(censusDiameter);
+    std::vector<float> metrics(curveLen);
+    const int curveCount = _cvt::NearNeighbors_<TArrange>::DIRECTION_NUM + _cvt::FarNeighbors_<TArrange>::DIRECTION_NUM;
+    for (int curveIdx = 0; curveIdx < curveCount; curveIdx++) {
+        overlaps.compareCurve(lhsMI, rhsMI, curveIdx, metrics);
+        for (int i = 0; i < curveLen; i++) {
+            const float expected = census::compare(lhsMI, rhsMI, overlaps.get(curveIdx * curveLen + i));
+            REQUIRE(isSameMetric(metrics[i], expected));
+        }
+    }
+}
+
+TEST_CASE("Census cost curves match the per-offset comparison", "tlct::_cvt::census#CensusOverlaps") {
+    const fs::path testdataDir{TLCT_TESTDATA_DIR};
+    fs::current_path(testdataDir);
+    cv::setRNGSeed(24);
+
+    SECTION("Corners arrange") {
+        const auto calibCfg = tlct::ConfigMap::createFromPath("test/清华单聚焦光场相机.cfg").value();
+        requireCurvesMatchCompare(tlct::cfg::CornersArrange::createWithCalibCfg(calibCfg).value());
+    }
+
+    SECTION("Offset arrange") {
+        const auto calibCfg = tlct::ConfigMap::createFromPath("test/raytrix.cfg").value();
+        requireCurvesMatchCompare(tlct::cfg::OffsetArrange::createWithCalibCfg(calibCfg).value());
+    }
+}
+
+// Every MI matches each of its near neighbors on its own, as before the edge curves were shared
+template <typename TArrange>
+static std::vector<float> estimateUnsharedPsizes(const TArrange& arrange, const cv::Mat& frame) {
+    using TNeighbors = _cvt::NearNeighbors_<TArrange>;
+
+    const auto params = census::PsizeParams_<TArrange>::create(arrange, CVT_CFG).value();
+    auto mis = census::MIBuffers_<TArrange>::create(arrange, CVT_CFG.bitDepth).value();
+    REQUIRE(mis.update(frame).has_value());
+    const auto overlaps = makeOverlaps(arrange, params, mis.getCensusDiameter());
+    const int curveLen = overlaps.getCurveLen();
+
+    std::vector<float> psizes(arrange.getMIRows() * arrange.getMIMaxCols());
+    for (int row = 0; row < arrange.getMIRows(); row++) {
+        for (int col = 0; col < arrange.getMICols(row); col++) {
+            const auto neighbors = TNeighbors::fromArrangeAndIndex(arrange, {col, row});
+            const census::MIBuffer& anchorMI = mis.getMI(row, col);
+
+            float sumPsize = 0;
+            float sumPsizeWeight = std::numeric_limits<float>::epsilon();
+            for (const auto direction : TNeighbors::DIRECTIONS) {
+                if (!neighbors.hasNeighbor(direction)) {
+                    continue;
+                }
+
+                const census::MIBuffer& neibMI = mis.getMI(neighbors.getNeighborIdx(direction));
+                int bestPsize = 0;
+                float maxMetric = std::numeric_limits<float>::lowest();
+                for (int psize = params.minPsize; psize < params.maxPsize; psize++) {
+                    const auto& overlap = overlaps.get((int)direction * curveLen + psize - params.minPsize);
+                    const float metric = census::compare(anchorMI, neibMI, overlap);
+                    if (metric > maxMetric) {
+                        maxMetric = metric;
+                        bestPsize = psize;
+                    }
+                }
+
+                const float weightedMetric = neibMI.grads * maxMetric;
+                sumPsize += bestPsize * weightedMetric;
+                sumPsizeWeight += weightedMetric;
+            }
+
+            const float clipedSumPsize =
+                _hp::clip(sumPsize / sumPsizeWeight, (float)params.minPsize, (float)params.maxPsize);
+            psizes[row * arrange.getMIMaxCols() + col] = clipedSumPsize / TNeighbors::INFLATE;
+        }
+    }
+    return psizes;
+}
+
+TEST_CASE("Census psizes match the unshared matching", "tlct::_cvt::census#PsizeImpl_") {
+    const fs::path testdataDir{TLCT_TESTDATA_DIR};
+    fs::current_path(testdataDir);
+    cv::setRNGSeed(25);
+
+    // Single focus, so no psize is adjusted after the matching. Nothing is inherited on the first frame.
+    using TArrange = tlct::cfg::CornersArrange;
+    using TPsizeImpl = census::PsizeImpl_<TArrange>;
+    const auto calibCfg = tlct::ConfigMap::createFromPath("test/清华单聚焦光场相机.cfg").value();
+    const auto arrange = TArrange::createWithCalibCfg(calibCfg).value();
+    REQUIRE(!arrange.isMultiFocus());
+
+    cv::Mat frame{arrange.getImgSize(), CV_8UC1};
+    cv::randu(frame, 0, 256);
+
+    auto psizeImpl = TPsizeImpl::create(arrange, CVT_CFG).value();
+    auto bridge = TPsizeImpl::TBridge::create(arrange).value();
+    REQUIRE(psizeImpl.updateBridge(frame, bridge).has_value());
+
+    const std::vector<float> expectedPsizes = estimateUnsharedPsizes(arrange, frame);
+    int mismatchCount = 0;
+    _cvt::forEachMIOffset(arrange, [&](int offset) {
+        if (bridge.getPatchsize(offset) != expectedPsizes[offset]) {
+            mismatchCount++;
+        }
+    });
+    REQUIRE(mismatchCount == 0);
+}
@@ -0,0 +1,91 @@
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tlct.hpp"
+
+#include "helper/io.hpp"
+
+namespace fs = std::filesystem;
+namespace _io = tlct::_io;
+
+TEST_CASE("Skip and read", "tlct::_io#YuvPlanarMmapReader") {
+    constexpr int FRAME_COUNT = 5;
+    for (const int bitDepth : {8, 10}) {
+        const auto extent = _io::YuvPlanarExtent::createYuv420p(8, 4, bitDepth).value();
+        const auto fpath = writeTemp("tlct_test_mmap_skip.yuv", makeYuv(extent, FRAME_COUNT));
+
+        {
+            auto reader = _io::YuvPlanarMmapReader::create(fpath, extent).value();
+            REQUIRE(reader.getFrameCount() == FRAME_COUNT);
+
+            REQUIRE(isFrameOf(reader.read().value(), 0));
+            REQUIRE(reader.skip(2).has_value());
+            REQUIRE(isFrameOf(reader.read().value(), 3));
+
+            // Neither backwards nor past the end, and a failed skip keeps the position
+            REQUIRE(!reader.skip(-1).has_value());
+            REQUIRE(!reader.skip(2).has_value());
+            REQUIRE(isFrameOf(reader.read().value(), 4));
+
+            // Skipping up to the end is fine, reading there is not
+            REQUIRE(reader.skip(0).has_value());
+            REQUIRE(!reader.read().has_value());
+        }
+
+        fs::remove(fpath);
+    }
+}
+
+TEST_CASE("A trailing partial frame is never read", "tlct::_io#YuvPlanarMmapReader") {
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    std::string content = makeYuv(extent, 2);
+    content.resize(content.size() + extent.getTotalByteSize() / 2);
+    const auto fpath = writeTemp("tlct_test_mmap_partial.yuv", content);
+
+    {
+        auto reader = _io::YuvPlanarMmapReader::create(fpath, extent).value();
+        REQUIRE(reader.getFrameCount() == 2);
+
+        auto frame = _io::YuvPlanarFrame::create(extent).value();
+        REQUIRE(reader.readInto(frame).has_value());
+        REQUIRE(isFrameOf(frame, 0));
+        REQUIRE(reader.readInto(frame).has_value());
+        REQUIRE(isFrameOf(frame, 1));
+        REQUIRE(!reader.readInto(frame).has_value());
+    }
+
+    fs::remove(fpath);
+}
+
+TEST_CASE("Views stay valid as long as the reader", "tlct::_io#YuvPlanarMmapReader") {
+    constexpr int FRAME_COUNT = 4;
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    const auto fpath = writeTemp("tlct_test_mmap_views.yuv", makeYuv(extent, FRAME_COUNT));
+
+    auto copiedFrame = _io::YuvPlanarFrame::create(extent).value();
+    {
+        auto reader = _io::YuvPlanarMmapReader::create(fpath, extent).value();
+
+        // Later reads never move or unmap the frames given out before
+        std::vector<_io::YuvPlanarFrame> views;
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT - 1; frameIdx++) {
+            views.push_back(reader.read().value());
+        }
+
+        // Neither does moving the reader, which carries the mapping along
+        auto movedReader = std::move(reader);
+        REQUIRE(movedReader.readInto(copiedFrame).has_value());
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT - 1; frameIdx++) {
+            REQUIRE(isFrameOf(views[frameIdx], frameIdx));
+        }
+    }
+
+    // `readInto` copies out of the mapping
+    REQUIRE(isFrameOf(copiedFrame, FRAME_COUNT - 1));
+
+    fs::remove(fpath);
+}
@@ -0,0 +1,57 @@
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+#include "tlct.hpp"
+
+#ifndef TLCT_TESTDATA_DIR
+#    define TLCT_TESTDATA_DIR "."
+#endif
+
+namespace fs = std::filesystem;
+namespace _cvt = tlct::_cvt;
+
+// The MIs whose neighbor in some direction does not see them back in the opposite direction
+template <typename TNeighbors>
+static int countAsymmetricMIs(const typename TNeighbors::TArrange& arrange) {
+    int count = 0;
+    for (int row = 0; row < arrange.getMIRows(); row++) {
+        for (int col = 0; col < arrange.getMICols(row); col++) {
+            const cv::Point index{col, row};
+            const auto neighbors = TNeighbors::fromArrangeAndIndex(arrange, index);
+            for (const auto direction : TNeighbors::DIRECTIONS) {
+                if (!neighbors.hasNeighbor(direction)) {
+                    continue;
+                }
+
+                const auto neib = TNeighbors::fromArrangeAndIndex(arrange, neighbors.getNeighborIdx(direction));
+                const auto opposite = TNeighbors::getOppositeDirection(direction);
+                if (!neib.hasNeighbor(opposite) || neib.getNeighborIdx(opposite) != index) {
+                    count++;
+                    break;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+TEST_CASE("Neighbors see each other in opposite directions", "tlct::_cvt#Neighbors") {
+    const fs::path testdataDir{TLCT_TESTDATA_DIR};
+    fs::current_path(testdataDir);
+
+    SECTION("Corners arrange") {
+        const auto calibCfg = tlct::ConfigMap::createFromPath("test/清华单聚焦光场相机.cfg").value();
+        const auto arrange = tlct::cfg::CornersArrange::createWithCalibCfg(calibCfg).value();
+        REQUIRE(countAsymmetricMIs<_cvt::NearNeighbors_<tlct::cfg::CornersArrange>>(arrange) == 0);
+        REQUIRE(countAsymmetricMIs<_cvt::FarNeighbors_<tlct::cfg::CornersArrange>>(arrange) == 0);
+    }
+
+    SECTION("Offset arrange") {
+        const auto calibCfg = tlct::ConfigMap::createFromPath("test/raytrix.cfg").value();
+        const auto arrange = tlct::cfg::OffsetArrange::createWithCalibCfg(calibCfg).value();
+        REQUIRE(countAsymmetricMIs<_cvt::NearNeighbors_<tlct::cfg::OffsetArrange>>(arrange) == 0);
+        REQUIRE(countAsymmetricMIs<_cvt::FarNeighbors_<tlct::cfg::OffsetArrange>>(arrange) == 0);
+    }
+}
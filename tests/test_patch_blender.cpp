@@ -0,0 +1,107 @@
+#include <cmath>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "tlct.hpp"
+
+#include "helper/mat.hpp"
+
+namespace _cvt = tlct::_cvt;
+
+// The float taps are summed in another order than the ones of `cv::resize`
+constexpr double EPS = 1e-3;
+
+TEST_CASE("Blend matches rotate, resize, multiply and add", "tlct::_cvt#PatchBlender") {
+    cv::setRNGSeed(16);
+    _cvt::PatchBlender blender;
+    constexpr float WEIGHT = 0.75f;
+
+    // Up and down sampling, with widths on and off the vector lanes
+    for (const auto [srcWidth, dstWidth] : {std::pair{23, 37}, std::pair{40, 21}, std::pair{16, 8}, std::pair{9, 64}}) {
+        const cv::Mat src = randomPlane({srcWidth, srcWidth}, CV_32FC1, 255.f);
+        const cv::Mat mask = randomPlane({dstWidth, dstWidth}, CV_32FC1, 1.f);
+
+        for (const bool rotate180 : {false, true}) {
+            const cv::Mat initDst = randomPlane(mask.size(), CV_32FC1, 255.f);
+            const cv::Mat initWeight = randomPlane(mask.size(), CV_32FC1, 1.f);
+
+            cv::Mat rotated;
+            if (rotate180) {
+                cv::rotate(src, rotated, cv::ROTATE_180);
+            } else {
+                rotated = src;
+            }
+            cv::Mat resized;
+            cv::resize(rotated, resized, mask.size(), 0, 0, cv::INTER_CUBIC);
+            const cv::Mat blendWeight = mask * WEIGHT;
+            const cv::Mat expectedDst = initDst + resized.mul(blendWeight);
+            const cv::Mat expectedWeight = initWeight + blendWeight;
+
+            cv::Mat dst = initDst.clone();
+            cv::Mat weightDst = initWeight.clone();
+            blender.blend(src, rotate180, mask, WEIGHT, dst, weightDst);
+            REQUIRE(maxAbsDiff(dst, expectedDst) < EPS);
+            REQUIRE(maxAbsDiff(weightDst, expectedWeight) < EPS);
+
+            // Without the weight canvas
+            cv::Mat noWeight;
+            dst = initDst.clone();
+            blender.blend(src, rotate180, mask, WEIGHT, dst, noWeight);
+            REQUIRE(maxAbsDiff(dst, expectedDst) < EPS);
+            REQUIRE(noWeight.empty());
+        }
+    }
+}
+
+TEST_CASE("Blend a sub-pixel window", "tlct::_cvt#PatchBlender") {
+    cv::setRNGSeed(17);
+    _cvt::PatchBlender blender;
+    constexpr float WEIGHT = 1.25f;
+
+    // A window of `width` pixels sampled by `dstWidth` pixels steps by `width / dstWidth`. When it starts at a
+    // multiple of that step, it is a crop of the whole plane resized by the same step.
+    // The plane is not square, so mixing up the axes of the transposed plane is caught.
+    const cv::Mat plane = randomPlane({30, 35}, CV_32FC1, 255.f);
+    cv::Mat transposedPlane;
+    cv::transpose(plane, transposedPlane);
+    for (const auto [dstWidth, width] : {std::pair{12, 7.5f}, std::pair{13, 16.25f}}) {
+        const float step = width / (float)dstWidth;
+        const cv::Size resizedSize{(int)std::round((float)plane.cols / step),
+                                   (int)std::round((float)plane.rows / step)};
+        cv::Mat resized;
+        cv::resize(plane, resized, resizedSize, 0, 0, cv::INTER_CUBIC);
+
+        const cv::Mat mask = randomPlane({dstWidth, dstWidth}, CV_32FC1, 1.f);
+        const cv::Mat blendWeight = mask * WEIGHT;
+        // Inside the plane, against the top-left border and against the bottom-right border
+        const cv::Point lastBegin{resizedSize.width - dstWidth, resizedSize.height - dstWidth};
+        for (const cv::Point begin : {cv::Point{5, 7}, cv::Point{0, 0}, lastBegin}) {
+            const cv::Point2f center{(float)begin.x * step + width / 2.f, (float)begin.y * step + width / 2.f};
+            const cv::Mat crop = resized({begin, mask.size()});
+
+            for (const bool rotate180 : {false, true}) {
+                cv::Mat sampled;
+                if (rotate180) {
+                    cv::rotate(crop, sampled, cv::ROTATE_180);
+                } else {
+                    sampled = crop;
+                }
+                const cv::Mat initDst = randomPlane(mask.size(), CV_32FC1, 255.f);
+                const cv::Mat expectedDst = initDst + sampled.mul(blendWeight);
+
+                // The transposed plane is addressed as the plane itself
+                for (const bool transposed : {false, true}) {
+                    cv::Mat dst = initDst.clone();
+                    cv::Mat weightDst = cv::Mat::zeros(mask.size(), CV_32FC1);
+                    blender.blend(transposed ? transposedPlane : plane, transposed, center, width, rotate180, mask,
+                                  WEIGHT, dst, weightDst);
+                    REQUIRE(maxAbsDiff(dst, expectedDst) < EPS);
+                    REQUIRE(maxAbsDiff(weightDst, blendWeight) < EPS);
+                }
+            }
+        }
+    }
+}
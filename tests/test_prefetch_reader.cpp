@@ -0,0 +1,103 @@
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+#include "tlct.hpp"
+
+#include "helper/io.hpp"
+
+namespace fs = std::filesystem;
+namespace _io = tlct::_io;
+
+template <typename TReader>
+static void requireStridedFrames(const fs::path& fpath, const _io::YuvPlanarExtent& extent) {
+    using TPrefetchReader = _io::PrefetchReader_<TReader>;
+
+    // Fewer slots than frames, so the producer wraps around the ring and blocks on it
+    auto prefetchReader = TPrefetchReader::create(TReader::create(fpath, extent).value(), extent, 2, 4, 2).value();
+
+    auto frame = _io::YuvPlanarFrame::create(extent).value();
+    for (const int frameIdx : {0, 2, 4, 6}) {
+        REQUIRE(prefetchReader.readInto(frame).has_value());
+        REQUIRE(isFrameOf(frame, frameIdx));
+    }
+    REQUIRE(!prefetchReader.readInto(frame).has_value());
+}
+
+TEST_CASE("Frames arrive in order", "tlct::_io#PrefetchReader") {
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    const auto fpath = writeTemp("tlct_test_prefetch_order.yuv", makeYuv(extent, 8));
+
+    requireStridedFrames<_io::YuvPlanarReader>(fpath, extent);
+    requireStridedFrames<_io::YuvPlanarMmapReader>(fpath, extent);
+
+    fs::remove(fpath);
+}
+
+template <typename TReader>
+static void requireFramesBeforeError(const fs::path& fpath, const _io::YuvPlanarExtent& extent) {
+    using TPrefetchReader = _io::PrefetchReader_<TReader>;
+
+    auto prefetchReader = TPrefetchReader::create(TReader::create(fpath, extent).value(), extent, 4, 4).value();
+
+    auto frame = _io::YuvPlanarFrame::create(extent).value();
+    for (const int frameIdx : {0, 1}) {
+        REQUIRE(prefetchReader.readInto(frame).has_value());
+        REQUIRE(isFrameOf(frame, frameIdx));
+    }
+    REQUIRE(!prefetchReader.readInto(frame).has_value());
+}
+
+TEST_CASE("Frames read before an error are delivered first", "tlct::_io#PrefetchReader") {
+    // The third frame is truncated
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    std::string content = makeYuv(extent, 3);
+    content.resize(content.size() - extent.getTotalByteSize() / 2);
+    const auto fpath = writeTemp("tlct_test_prefetch_error.yuv", content);
+
+    requireFramesBeforeError<_io::YuvPlanarReader>(fpath, extent);
+    requireFramesBeforeError<_io::YuvPlanarMmapReader>(fpath, extent);
+
+    fs::remove(fpath);
+}
+
+#ifndef _WIN32
+
+TEST_CASE("Destruction does not wait for a blocked pipe", "tlct::_io#PrefetchReader") {
+    using TPrefetchReader = _io::PrefetchReader_<_io::YuvPlanarReader>;
+
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    // Only the first frame is ever sent, the write end stays open
+    const std::string content = makeYuv(extent, 1);
+    REQUIRE(write(fds[1], content.data(), content.size()) == (ssize_t)content.size());
+
+    {
+        const fs::path pipePath = std::format("/dev/fd/{}", fds[0]);
+        auto prefetchReader =
+            TPrefetchReader::create(_io::YuvPlanarReader::create(pipePath, extent).value(), extent, 2, 4).value();
+
+        auto frame = _io::YuvPlanarFrame::create(extent).value();
+        REQUIRE(prefetchReader.readInto(frame).has_value());
+        REQUIRE(isFrameOf(frame, 0));
+
+        // Let the producer block on the second frame, then leave the scope. This hangs if the producer is joined.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    // Unblock the detached producer
+    close(fds[1]);
+    close(fds[0]);
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "tlct.hpp"
+
+#include "helper/mat.hpp"
+
+namespace _cvt = tlct::_cvt;
+
+TEST_CASE("Normalized resize clamps to the output bit depth", "tlct::_cvt#normalizeResize") {
+    constexpr int MAX_VALUE = (1 << 10) - 1;
+    const cv::Size srcSize{64, 64};
+    const cv::Size dstSize{96, 96};
+
+    // A step edge up to white, which the cubic taps overshoot
+    cv::Mat src{srcSize, CV_32FC1, cv::Scalar::all(0)};
+    src.colRange(srcSize.width / 2, srcSize.width).setTo(MAX_VALUE);
+    const cv::Mat scale{srcSize, CV_32FC1, cv::Scalar::all(1)};
+
+    cv::Mat unclamped;
+    cv::resize(src, unclamped, dstSize, 0, 0, cv::INTER_CUBIC);
+    double unclampedMax;
+    cv::minMaxLoc(unclamped, nullptr, &unclampedMax);
+    REQUIRE(unclampedMax > MAX_VALUE);
+
+    for (const bool transposed : {false, true}) {
+        cv::Mat dst{dstSize, CV_16UC1};
+        _cvt::normalizeResize(src, scale, dst, dstSize, transposed, MAX_VALUE);
+
+        double dstMax;
+        cv::minMaxLoc(dst, nullptr, &dstMax);
+        REQUIRE(dstMax == MAX_VALUE);
+    }
+}
+
+TEST_CASE("Transposed resize matches transpose then resize", "tlct::_cvt#transposeResize") {
+    cv::setRNGSeed(9);
+    for (const int type : {CV_8UC1, CV_16UC1}) {
+        for (const cv::Size srcSize : {cv::Size{53, 37}, cv::Size{9, 5}, cv::Size{48, 64}}) {
+            const cv::Mat src = randomPlane(srcSize, type, type == CV_8UC1 ? 256 : 65536);
+            cv::Mat transposed;
+            cv::transpose(src, transposed);
+
+            for (const int upsample : {1, 2, 3}) {
+                const cv::Size dstSize{srcSize.height * upsample, srcSize.width * upsample};
+                cv::Mat expected;
+                cv::resize(transposed, expected, dstSize, 0, 0, cv::INTER_CUBIC);
+
+                cv::Mat dst;
+                _cvt::transposeResize(src, dst, dstSize);
+                REQUIRE(dst.type() == type);
+                REQUIRE(dst.size() == dstSize);
+                // The axes are resampled in the other order, which only moves the rounding
+                REQUIRE(maxAbsDiff(dst, expected) <= 1.0);
+            }
+
+            // Not an integer factor
+            const cv::Size oddSize{srcSize.height * 2 + 3, srcSize.width + 7};
+            cv::Mat expected;
+            cv::resize(transposed, expected, oddSize, 0, 0, cv::INTER_CUBIC);
+            cv::Mat dst;
+            _cvt::transposeResize(src, dst, oddSize);
+            REQUIRE(maxAbsDiff(dst, expected) <= 1.0);
+        }
+    }
+}
+
+TEST_CASE("Transposed conversion matches transpose then convert", "tlct::_cvt#transposeConvert") {
+    cv::setRNGSeed(10);
+    for (const int type : {CV_8UC1, CV_16UC1}) {
+        // Not a multiple of the tile size
+        const cv::Mat src = randomPlane({71, 45}, type, type == CV_8UC1 ? 256 : 65536);
+        cv::Mat expected;
+        cv::transpose(src, expected);
+        cv::Mat expectedF32;
+        expected.convertTo(expectedF32, CV_32FC1);
+
+        cv::Mat dst;
+        cv::Mat f32Dst;
+        _cvt::transposeConvert(src, dst, f32Dst);
+        REQUIRE(dst.type() == type);
+        REQUIRE(f32Dst.type() == CV_32FC1);
+        REQUIRE(maxAbsDiff(dst, expected) == 0.0);
+        REQUIRE(maxAbsDiff(f32Dst, expectedF32) == 0.0);
+    }
+}
+
+TEST_CASE("Normalized resize matches resize of the normalized source", "tlct::_cvt#normalizeResize") {
+    cv::setRNGSeed(18);
+    for (const int type : {CV_8UC1, CV_16UC1}) {
+        const int maxValue = type == CV_8UC1 ? 255 : 65535;
+        for (const bool transposed : {false, true}) {
+            const cv::Size srcSize{45, 38};
+            cv::Mat src{srcSize, CV_32FC1};
+            cv::randu(src, 0.f, (float)maxValue);
+            cv::Mat scale{srcSize, CV_32FC1};
+            cv::randu(scale, 0.5f, 1.f);
+
+            cv::Mat normed = src.mul(scale);
+            if (transposed) {
+                cv::Mat transposedNormed;
+                cv::transpose(normed, transposedNormed);
+                normed = transposedNormed;
+            }
+
+            for (const cv::Size dstSize : {cv::Size{normed.cols * 2, normed.rows * 2}, cv::Size{29, 61}}) {
+                cv::Mat expected;
+                cv::resize(normed, expected, dstSize, 0, 0, cv::INTER_CUBIC);
+                expected.convertTo(expected, type);
+
+                cv::Mat dst{dstSize, type};
+                _cvt::normalizeResize(src, scale, dst, dstSize, transposed, maxValue);
+                REQUIRE(dst.size() == dstSize);
+                // The products and taps are rounded in another order
+                REQUIRE(maxAbsDiff(dst, expected) <= 1.0);
+
+                // Any window only needs the source pixels reported by `getResizeSrcRoi`
+                for (const cv::Rect dstRoi : {cv::Rect{0, 0, 7, 5}, cv::Rect{11, 17, 13, 9},
+                                              cv::Rect{dstSize.width - 10, dstSize.height - 3, 10, 3}}) {
+                    const cv::Rect srcRoi = _cvt::getResizeSrcRoi(srcSize, dstRoi, dstSize, transposed);
+                    REQUIRE((srcRoi & cv::Rect{{0, 0}, srcSize}) == srcRoi);
+
+                    cv::Mat window{dstRoi.size(), type};
+                    _cvt::normalizeResize(src(srcRoi), scale(srcRoi), srcRoi.tl(), srcSize, window, dstRoi, dstSize,
+                                          transposed, maxValue);
+                    REQUIRE(maxAbsDiff(window, dst(dstRoi)) == 0.0);
+                }
+            }
+        }
+    }
+}
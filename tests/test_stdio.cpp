@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+#include "tlct.hpp"
+
+#include "helper/io.hpp"
+
+namespace _io = tlct::_io;
+
+TEST_CASE("Only a bare dash stands for stdio", "tlct::_io#isStdioPath") {
+    REQUIRE(_io::isStdioPath("-"));
+    REQUIRE(!_io::isStdioPath("--"));
+    REQUIRE(!_io::isStdioPath("dir/-"));
+    REQUIRE(!_io::isStdioPath("a.yuv"));
+}
+
+#ifndef _WIN32
+
+TEST_CASE("Read frames from stdin", "tlct::_io#YuvPlanarReader") {
+    constexpr int FRAME_COUNT = 4;
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+
+    // Far below the pipe capacity, so all frames are sent before reading
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    const std::string content = makeYuv(extent, FRAME_COUNT);
+    REQUIRE(write(fds[1], content.data(), content.size()) == (ssize_t)content.size());
+    close(fds[1]);
+
+    const int savedStdin = dup(STDIN_FILENO);
+    dup2(fds[0], STDIN_FILENO);
+    close(fds[0]);
+    auto readerRes = _io::YuvPlanarReader::create(_io::STDIO_PATH, extent);
+    dup2(savedStdin, STDIN_FILENO);
+    close(savedStdin);
+
+    auto& reader = readerRes.value();
+    // A pipe is skipped forwards by discarding
+    REQUIRE(reader.skip(1).has_value());
+    REQUIRE(!reader.skip(-1).has_value());
+    REQUIRE(isFrameOf(reader.read().value(), 1));
+    REQUIRE(isFrameOf(reader.read().value(), 2));
+    REQUIRE(isFrameOf(reader.read().value(), 3));
+    REQUIRE(!reader.read().has_value());
+}
+
+TEST_CASE("Write frames to stdout", "tlct::_io#YuvPlanarWriter") {
+    constexpr int FRAME_COUNT = 2;
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    // Nothing of the test reporter may end up in the pipe
+    std::cout.flush();
+    std::fflush(stdout);
+    const int savedStdout = dup(STDOUT_FILENO);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    {
+        auto writerRes = _io::YuvPlanarWriter::create(_io::STDIO_PATH);
+        if (writerRes) {
+            auto frame = _io::YuvPlanarFrame::create(extent).value();
+            for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+                fillFrame(frame, frameIdx);
+                (void)writerRes->write(frame);
+            }
+        }
+    }
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+
+    // Every write end is closed by now, so the read below stops at the end of the frames
+    std::string received(extent.getTotalByteSize() * (FRAME_COUNT + 1), '\0');
+    size_t receivedSize = 0;
+    ssize_t readSize;
+    while ((readSize = read(fds[0], received.data() + receivedSize, received.size() - receivedSize)) > 0) {
+        receivedSize += readSize;
+    }
+    close(fds[0]);
+
+    received.resize(receivedSize);
+    REQUIRE(received == makeYuv(extent, FRAME_COUNT));
+}
+
+#endif
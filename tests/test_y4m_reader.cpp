@@ -0,0 +1,95 @@
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tlct.hpp"
+
+#include "helper/io.hpp"
+
+namespace fs = std::filesystem;
+namespace _io = tlct::_io;
+
+static std::string makeY4m(std::string_view headerLine, const _io::YuvPlanarExtent& extent,
+                           const std::vector<std::string>& frameLines) {
+    std::string content{headerLine};
+    for (size_t frameIdx = 0; frameIdx < frameLines.size(); frameIdx++) {
+        content += frameLines[frameIdx];
+        content += '\n';
+        appendFrame(content, extent, (int)frameIdx);
+    }
+    return content;
+}
+
+TEST_CASE("Read C420jpeg", "tlct::_io#Y4mReader") {
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(8, 4).value();
+    const std::vector<std::string> frameLines(4, "FRAME");
+    const auto fpath = writeTemp("tlct_test_420jpeg.y4m",
+                                 makeY4m("YUV4MPEG2 W8 H4 F25:1 Ip A1:1 C420jpeg\n", extent, frameLines));
+
+    auto reader = _io::Y4mReader::create(fpath).value();
+    REQUIRE(reader.getExtent().getBitDepth() == 8);
+    REQUIRE(reader.getFrameCount() == 4);
+
+    for (int frameIdx = 0; frameIdx < 4; frameIdx++) {
+        REQUIRE(isFrameOf(reader.read().value(), frameIdx));
+    }
+    REQUIRE(!reader.read().has_value());
+
+    REQUIRE(reader.seek(2).has_value());
+    REQUIRE(isFrameOf(reader.read().value(), 2));
+    REQUIRE(reader.getFrameIdx() == 3);
+
+    fs::remove(fpath);
+}
+
+TEST_CASE("Read C420p10", "tlct::_io#Y4mReader") {
+    const auto extent = _io::YuvPlanarExtent::createWithBitDepth(8, 4, 10, 1, 1).value();
+    const std::vector<std::string> frameLines(3, "FRAME");
+    const auto fpath =
+        writeTemp("tlct_test_420p10.y4m", makeY4m("YUV4MPEG2 W8 H4 F25:1 Ip A1:1 C420p10\n", extent, frameLines));
+
+    auto reader = _io::Y4mReader::create(fpath).value();
+    REQUIRE(reader.getExtent().getBitDepth() == 10);
+    REQUIRE(reader.getExtent().getDepth() == 2);
+    REQUIRE(reader.getFrameCount() == 3);
+
+    REQUIRE(reader.seek(1).has_value());
+    REQUIRE(isFrameOf(reader.read().value(), 1));
+    REQUIRE(isFrameOf(reader.read().value(), 2));
+    REQUIRE(reader.seek(0).has_value());
+    REQUIRE(isFrameOf(reader.read().value(), 0));
+
+    fs::remove(fpath);
+}
+
+TEST_CASE("Read a parameterised middle frame", "tlct::_io#Y4mReader") {
+    constexpr int FRAME_COUNT = 5;
+    const auto extent = _io::YuvPlanarExtent::createYuv420p8bit(4, 2).value();
+    const int stride = (int)_io::Y4mHeader::FRAME_MAGIC.size() + 1 + extent.getTotalByteSize();
+
+    // A short parameter is caught on open. A parameter as long as one frame keeps the file size a multiple of
+    // the stride and leaves a bare frame line at the arithmetic last offset, so it is only caught on read.
+    const std::string shortParam = "FRAME Ixyz";
+    const std::string strideParam = "FRAME " + std::string(stride - 1, 'X');
+
+    for (const auto& middleLine : {shortParam, strideParam}) {
+        std::vector<std::string> frameLines(FRAME_COUNT, "FRAME");
+        frameLines[FRAME_COUNT / 2] = middleLine;
+        const auto fpath = writeTemp("tlct_test_param_frame.y4m",
+                                     makeY4m("YUV4MPEG2 W4 H2 F25:1 Ip A1:1 C420jpeg\n", extent, frameLines));
+
+        auto reader = _io::Y4mReader::create(fpath).value();
+        for (int frameIdx = 0; frameIdx < FRAME_COUNT; frameIdx++) {
+            REQUIRE(isFrameOf(reader.read().value(), frameIdx));
+        }
+        REQUIRE(reader.getFrameCount() == FRAME_COUNT);
+
+        REQUIRE(reader.seek(FRAME_COUNT - 1).has_value());
+        REQUIRE(isFrameOf(reader.read().value(), FRAME_COUNT - 1));
+
+        fs::remove(fpath);
+    }
+}